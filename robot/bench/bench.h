@@ -0,0 +1,40 @@
+// Micro-benchmarks for the control and render hot paths.
+// The cases (bench_cases.cpp) are shared; bench_host.cpp times them in ns/op
+// with a steady clock, bench_avr.cpp in CPU cycles/op with Timer1 (plus px/s
+// for the panel cases).
+#pragma once
+
+#include <Arduino.h>
+#include "flash.h"
+
+struct BenchCase {
+    const char* name;
+    void (*setup)();           // Optional, runs once before timing
+    void (*run)(uint16_t i);   // One operation; i varies the input
+    uint16_t hostIterations;
+    uint16_t avrIterations;
+};
+
+extern const BenchCase BENCH_CASES[];
+extern const size_t NUM_BENCH_CASES;
+
+// Render-task cases, one per entry in renderTasks[] (full redraw of that widget)
+size_t benchRenderCaseCount();
+FlashString benchRenderCaseName(size_t idx);
+void benchRenderSetup();
+void benchRenderRun(size_t idx);
+
+// Panel throughput cases: the same drawing through Adafruit_ST7789 and through
+// LeanST7789, each on its own driver object on the panel pins
+struct PanelCase {
+    const char* name;
+    void (*run)();
+    uint16_t pixels;           // Pixels sent per op
+};
+
+extern const PanelCase PANEL_CASES[];
+extern const size_t NUM_PANEL_CASES;
+void benchPanelSetup();
+
+// Written by cases so the compiler cannot drop their work
+extern volatile int32_t benchSink;
@@ -0,0 +1,98 @@
+// On-target runner (pio run -e uno_bench -t upload && pio device monitor -e uno_bench).
+// Times each case with Timer1 at the CPU clock, so results are in cycles. Servos are
+// never attached in this build, which leaves Timer1 to the benchmark.
+#include <Arduino.h>
+#include "bench.h"
+
+static volatile uint16_t timer1Overflows;
+
+ISR(TIMER1_OVF_vect) {
+    timer1Overflows++;
+}
+
+static void timerStart() {
+    TCCR1A = 0;
+    TCCR1B = 0;
+    TCNT1 = 0;
+    timer1Overflows = 0;
+    TIFR1 = _BV(TOV1);
+    TIMSK1 = _BV(TOIE1);
+    TCCR1B = _BV(CS10); // clk/1
+}
+
+static uint32_t timerStop() {
+    TCCR1B = 0;
+    uint32_t cycles = ((uint32_t)timer1Overflows << 16) | TCNT1;
+    if (TIFR1 & _BV(TOV1)) cycles += 0x10000UL; // Overflow raced the stop
+    TIMSK1 = 0;
+    return cycles;
+}
+
+static void emptyCase(uint16_t i) {
+    benchSink += i;
+}
+
+static uint32_t timeCase(void (*run)(uint16_t), uint16_t iterations) {
+    timerStart();
+    for (uint16_t i = 0; i < iterations; ++i) run(i);
+    return timerStop();
+}
+
+static void report(const char* name, uint32_t cycles, uint16_t iterations) {
+    Serial.print(F("bench "));
+    Serial.print(name);
+    Serial.print(' ');
+    Serial.print(cycles / iterations);
+    Serial.println(F(" cycles/op"));
+    Serial.flush(); // Keep UART interrupts out of the next measurement
+}
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println(F("# name cycles/op [px/s]"));
+
+    // Loop and call overhead, subtracted from every control case
+    const uint16_t calibrationIterations = 200;
+    uint32_t overheadPerOp = timeCase(emptyCase, calibrationIterations) / calibrationIterations;
+
+    for (size_t c = 0; c < NUM_BENCH_CASES; ++c) {
+        const BenchCase &bc = BENCH_CASES[c];
+        if (bc.setup) bc.setup();
+        uint32_t cycles = timeCase(bc.run, bc.avrIterations);
+        uint32_t overhead = overheadPerOp * bc.avrIterations;
+        report(bc.name, cycles > overhead ? cycles - overhead : 0, bc.avrIterations);
+    }
+
+    benchRenderSetup();
+    const uint16_t renderIterations = 4;
+    for (size_t t = 0; t < benchRenderCaseCount(); ++t) {
+        timerStart();
+        for (uint16_t i = 0; i < renderIterations; ++i) benchRenderRun(t);
+        uint32_t cycles = timerStop();
+        char name[32];
+        snprintf_P(name, sizeof(name), PSTR("render_%S"), flashPtr(benchRenderCaseName(t)));
+        report(name, cycles, renderIterations);
+    }
+
+    // Pixels per second on the wire: cycles include CS, window commands and glyph composition
+    benchPanelSetup();
+    const uint16_t panelIterations = 4;
+    for (size_t c = 0; c < NUM_PANEL_CASES; ++c) {
+        const PanelCase &pc = PANEL_CASES[c];
+        timerStart();
+        for (uint16_t i = 0; i < panelIterations; ++i) pc.run();
+        uint32_t cycles = timerStop() / panelIterations;
+        Serial.print(F("bench "));
+        Serial.print(pc.name);
+        Serial.print(' ');
+        Serial.print(cycles);
+        Serial.print(F(" cycles/op "));
+        Serial.print((uint32_t)((float)F_CPU * pc.pixels / cycles));
+        Serial.println(F(" px/s"));
+        Serial.flush();
+    }
+    Serial.println(F("# done"));
+}
+
+void loop() {
+}
@@ -0,0 +1,140 @@
+#include <Arduino.h>
+#include "bench.h"
+#include "control.h"
+#include "config.h"
+#include "display.h"
+#include "st7789_lean.h"
+#include "trace.h"
+
+volatile int32_t benchSink;
+
+static void benchInterpolateDirection(uint16_t i) {
+    ServoAngles a = interpolateDirection((i * 7u) % 360u + 0.5f);
+    benchSink += a.angle[0] + a.angle[1] + a.angle[2];
+}
+
+static void benchJoystickPolar(uint16_t i) {
+    float angle, strength;
+    if (joystickPolar((i * 37u) & 1023, (i * 91u) & 1023, angle, strength)) {
+        benchSink += (int32_t)(angle + strength * 100.0f);
+    }
+}
+
+static void benchMapJoystickToServos(uint16_t i) {
+    mapJoystickToServos();
+    benchSink += joystickX;
+}
+
+static void benchHandleButtons(uint16_t i) {
+    handleButtons();
+    benchSink += buttons[0].stableState;
+}
+
+static void benchMoveServos(uint16_t i) {
+    float a = 60.0f + (i & 63);
+    float pose[ARM_AXES] = ARM_AXES_INIT(a, 180.0f - a, a * 0.5f, a);
+    moveServos(pose);
+    benchSink += (int32_t)currentServoPos[0];
+}
+
+// Half the inputs fall outside the default profile's limits
+static void benchArmClamp(uint16_t i) {
+    const MotionTables &m = motion();
+    float a = (i & 255) * 0.8f;
+    float pose[ARM_AXES] = ARM_AXES_INIT(a, 200.0f - a, a * 1.5f, a);
+    float out[ARM_AXES];
+    armClamp<ARM_AXES>(pose, m.minAngle, m.maxAngle, out);
+    benchSink += (int32_t)out[0];
+}
+
+static void benchTraceRecord(uint16_t i) {
+    traceRecord(TRACE_BUTTON, i);
+}
+
+static void setupTrace() {
+    traceSetup(false);
+}
+
+static void setupServos() {
+    for (uint8_t i = 0; i < ARM_AXES; ++i) currentServoPos[i] = 90.0f;
+}
+
+const BenchCase BENCH_CASES[] = {
+    { "interpolate_direction",  NULL,        benchInterpolateDirection, 50000, 200 },
+    { "joystick_polar",         NULL,        benchJoystickPolar,        50000, 200 },
+    { "map_joystick_to_servos", setupServos, benchMapJoystickToServos,  50000, 100 },
+    { "handle_buttons",         NULL,        benchHandleButtons,        50000, 100 },
+    { "move_servos",            setupServos, benchMoveServos,           50000, 100 },
+    { "arm_clamp",              NULL,        benchArmClamp,             50000, 200 },
+    { "trace_record",           setupTrace,  benchTraceRecord,          50000, 200 }
+};
+const size_t NUM_BENCH_CASES = sizeof(BENCH_CASES) / sizeof(BenchCase);
+
+size_t benchRenderCaseCount() {
+    return NUM_RENDER_TASKS;
+}
+
+FlashString benchRenderCaseName(size_t idx) {
+    return renderTasks[idx].name;
+}
+
+// Bring the panel up so widget redraws hit an initialized display
+void benchRenderSetup() {
+    setupDisplay();
+    delay(10);
+    while (!displayBootStep()) delay(1); // The init command list waits between commands
+    timeToFirstControlUs = 1000; // Lets the boot-time widget draw
+}
+
+// One full redraw of a widget: invalidate, then step until the task reports completion
+void benchRenderRun(size_t idx) {
+    RenderTask &task = renderTasks[idx];
+    displayInvalidateAll();
+    while (!task.step(task.arg)) {}
+}
+
+// --- Panel throughput ---
+// 64x16 fills: blue needs every bit clocked, white takes the lean clock-only path.
+// Text is a 13-character label, black on white, as the status lines print it.
+static Adafruit_ST7789 adafruitPanel(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, -1);
+static LeanST7789 leanPanel(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, -1);
+const char PANEL_TEXT_P[] PROGMEM = "Profile: Fast";
+const int16_t PANEL_FILL_W = 64, PANEL_FILL_H = 16;
+
+template <class Panel> static void panelFill(Panel &panel, uint16_t color) {
+    panel.fillRect(0, 40, PANEL_FILL_W, PANEL_FILL_H, color);
+}
+
+template <class Panel> static void panelText(Panel &panel) {
+    panel.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+    panel.setCursor(0, 40);
+    panel.print(asFlash(PANEL_TEXT_P));
+}
+
+static void fillAdafruit()  { panelFill(adafruitPanel, ST77XX_BLUE); }
+static void fillLean()      { panelFill(leanPanel, ST77XX_BLUE); }
+static void clearAdafruit() { panelFill(adafruitPanel, ST77XX_WHITE); }
+static void clearLean()     { panelFill(leanPanel, ST77XX_WHITE); }
+static void textAdafruit()  { panelText(adafruitPanel); }
+static void textLean()      { panelText(leanPanel); }
+
+const uint16_t PANEL_FILL_PIXELS = PANEL_FILL_W * PANEL_FILL_H;
+const uint16_t PANEL_TEXT_PIXELS = (sizeof(PANEL_TEXT_P) - 1) * 6 * 8;
+
+const PanelCase PANEL_CASES[] = {
+    { "panel_fill_adafruit",  fillAdafruit,  PANEL_FILL_PIXELS },
+    { "panel_fill_lean",      fillLean,      PANEL_FILL_PIXELS },
+    { "panel_clear_adafruit", clearAdafruit, PANEL_FILL_PIXELS },
+    { "panel_clear_lean",     clearLean,     PANEL_FILL_PIXELS },
+    { "panel_text_adafruit",  textAdafruit,  PANEL_TEXT_PIXELS },
+    { "panel_text_lean",      textLean,      PANEL_TEXT_PIXELS }
+};
+const size_t NUM_PANEL_CASES = sizeof(PANEL_CASES) / sizeof(PanelCase);
+
+// Both drivers run the full bring-up so each has its pins and rotation set
+void benchPanelSetup() {
+    adafruitPanel.init(240, 320);
+    adafruitPanel.setRotation(1);
+    leanPanel.init(240, 320);
+    leanPanel.setRotation(1);
+}
@@ -0,0 +1,62 @@
+// Host runner: make -C tools bench && tools/build/bench
+#include <chrono>
+#include <cstdio>
+#include "arduino_host.h"
+#include "Adafruit_GFX.h"
+#include "bench.h"
+
+static const int REPEATS = 5; // Best of, to filter scheduler noise
+
+template <class Fn> static double bestNsPerOp(Fn fn, unsigned long iterations) {
+    double best = 1e30;
+    for (int r = 0; r < REPEATS; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn(iterations);
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        if (ns < best) best = ns;
+    }
+    return best;
+}
+
+int main() {
+    hostReset();
+    printf("# name ns/op [px/op windows/op]\n");
+    for (size_t c = 0; c < NUM_BENCH_CASES; ++c) {
+        const BenchCase &bc = BENCH_CASES[c];
+        if (bc.setup) bc.setup();
+        double ns = bestNsPerOp([&](unsigned long n) {
+            for (unsigned long i = 0; i < n; ++i) bc.run((uint16_t)i);
+        }, bc.hostIterations);
+        printf("bench %-24s %10.1f ns/op\n", bc.name, ns);
+    }
+
+    benchRenderSetup();
+    for (size_t t = 0; t < benchRenderCaseCount(); ++t) {
+        const unsigned long iterations = 20000;
+        hostTftStats = HostTftStats();
+        benchRenderRun(t);
+        HostTftStats perOp = hostTftStats;
+        double ns = bestNsPerOp([&](unsigned long n) {
+            for (unsigned long i = 0; i < n; ++i) benchRenderRun(t);
+        }, iterations);
+        char name[40];
+        snprintf(name, sizeof(name), "render_%s", flashPtr(benchRenderCaseName(t)));
+        printf("bench %-24s %10.1f ns/op %8lu px/op %4lu windows/op\n", name, ns, perOp.pixels, perOp.windows);
+    }
+
+    // The mock panel clocks nothing out, so host time is driver CPU overhead only;
+    // px/s against the wire comes from the uno_bench run
+    benchPanelSetup();
+    for (size_t c = 0; c < NUM_PANEL_CASES; ++c) {
+        const PanelCase &pc = PANEL_CASES[c];
+        hostTftStats = HostTftStats();
+        pc.run();
+        HostTftStats perOp = hostTftStats;
+        double ns = bestNsPerOp([&](unsigned long n) {
+            for (unsigned long i = 0; i < n; ++i) pc.run();
+        }, 20000);
+        printf("bench %-24s %10.1f ns/op %8lu px/op %4lu windows/op\n", pc.name, ns, perOp.pixels, perOp.windows);
+    }
+    return 0;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Arm core: the axis count and the per-axis kernels. Per-axis state lives in
+// parallel arrays, one per quantity (currentServoPos, the limit and center
+// tables in MotionTables, ...), indexed by axis; axis 0 is the base.
+//
+// ARM_AXES is fixed per build (platformio.ini: env:uno_arm4, env:uno_arm5).
+// The first ARM_STEERED_AXES axes are yaw, shoulder and elbow: the joystick
+// direction table, the macros and the workspace map cover those. Further axes
+// (wrist, gripper) get their own limits and center and follow the UP/DOWN
+// steps, soft start, pose store, watchdog note and link; otherwise they hold.
+//
+// There is no template<size_t N> arm class with constexpr limits: the limits
+// and centers belong to the motion profile (config.h), which the UP+DOWN chord
+// switches at run time and the EEPROM config block can rewrite. So they stay in
+// MotionTables, and N is a template parameter of each kernel instead.
+
+#ifndef ARM_AXES
+#define ARM_AXES 3
+#endif
+
+const uint8_t ARM_MAX_AXES = 5;      // Servo pins and trace tags exist for this many
+const uint8_t ARM_STEERED_AXES = 3;
+static_assert(ARM_AXES >= ARM_STEERED_AXES && ARM_AXES <= ARM_MAX_AXES, "ARM_AXES must be 3, 4 or 5");
+
+// Per-axis initializer for the factory tables: the steered axes, then one value for the rest
+#if ARM_AXES == 3
+#define ARM_AXES_INIT(a, b, c, rest) { a, b, c }
+#elif ARM_AXES == 4
+#define ARM_AXES_INIT(a, b, c, rest) { a, b, c, rest }
+#else
+#define ARM_AXES_INIT(a, b, c, rest) { a, b, c, rest, rest }
+#endif
+
+#define ARM_INLINE inline __attribute__((always_inline))
+
+// ArmUnroll<End, Begin>::run(k) calls k(Begin) ... k(End - 1), expanded by
+// template recursion and forced inline, so one kernel source serves any
+// ARM_AXES. (C++11: no fold expressions, and avr-gcc 7 has no loop unroll pragma.)
+// It exists for the axis count, not for speed: no AVR cycle counts compare it
+// with the old hand-written three-axis code (bench/baseline.txt).
+template <uint8_t End, uint8_t Begin = 0>
+struct ArmUnroll {
+    template <typename Kernel> static ARM_INLINE void run(Kernel &k) {
+        k(Begin);
+        ArmUnroll<End, Begin + 1>::run(k);
+    }
+};
+
+template <uint8_t End>
+struct ArmUnroll<End, End> {
+    template <typename Kernel> static ARM_INLINE void run(Kernel &) {}
+};
+
+// out = a blended toward b, rounded to whole degrees (joystick direction table)
+template <uint8_t N>
+ARM_INLINE void armBlend(const uint8_t* a, const uint8_t* b, float blend, int* out) {
+    struct Kernel {
+        const uint8_t *a, *b;
+        float keep, blend;
+        int* out;
+        ARM_INLINE void operator()(uint8_t i) { out[i] = round(a[i] * keep + b[i] * blend); }
+    } k = { a, b, 1.0f - blend, blend, out };
+    ArmUnroll<N>::run(k);
+}
+
+// out = from moved toward target by rate (0-1) of the remaining distance
+template <uint8_t N>
+ARM_INLINE void armApproach(const float* from, const int* target, float rate, float* out) {
+    struct Kernel {
+        const float* from;
+        const int* target;
+        float rate;
+        float* out;
+        ARM_INLINE void operator()(uint8_t i) { out[i] = from[i] + (target[i] - from[i]) * rate; }
+    } k = { from, target, rate, out };
+    ArmUnroll<N>::run(k);
+}
+
+// out = from moved toward target by at most maxStep per axis; returns true if any axis moved
+template <uint8_t N>
+ARM_INLINE bool armSlew(const float* from, const float* target, float maxStep, float* out) {
+    struct Kernel {
+        const float *from, *target;
+        float maxStep;
+        float* out;
+        bool moved;
+        ARM_INLINE void operator()(uint8_t i) {
+            float delta = constrain(target[i] - from[i], -maxStep, maxStep);
+            if (delta != 0.0f) moved = true;
+            out[i] = from[i] + delta;
+        }
+    } k = { from, target, maxStep, out, false };
+    ArmUnroll<N>::run(k);
+    return k.moved;
+}
+
+// out = in + offset on every axis
+template <uint8_t N>
+ARM_INLINE void armOffset(const float* in, float offset, float* out) {
+    struct Kernel {
+        const float* in;
+        float offset;
+        float* out;
+        ARM_INLINE void operator()(uint8_t i) { out[i] = in[i] + offset; }
+    } k = { in, offset, out };
+    ArmUnroll<N>::run(k);
+}
+
+// out = in limited to [lo, hi] per axis
+template <uint8_t N>
+ARM_INLINE void armClamp(const float* in, const float* lo, const float* hi, float* out) {
+    struct Kernel {
+        const float *in, *lo, *hi;
+        float* out;
+        ARM_INLINE void operator()(uint8_t i) { out[i] = constrain(in[i], lo[i], hi[i]); }
+    } k = { in, lo, hi, out };
+    ArmUnroll<N>::run(k);
+}
+
+// Axes Begin .. End - 1 of out = in
+template <uint8_t End, uint8_t Begin>
+ARM_INLINE void armCopy(const float* in, float* out) {
+    struct Kernel {
+        const float* in;
+        float* out;
+        ARM_INLINE void operator()(uint8_t i) { out[i] = in[i]; }
+    } k = { in, out };
+    ArmUnroll<End, Begin>::run(k);
+}
+
+template <uint8_t N>
+ARM_INLINE bool armEqual(const float* a, const float* b) {
+    struct Kernel {
+        const float *a, *b;
+        bool equal;
+        ARM_INLINE void operator()(uint8_t i) { if (a[i] != b[i]) equal = false; }
+    } k = { a, b, true };
+    ArmUnroll<N>::run(k);
+    return k.equal;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <Arduino.h>
+#include "arm.h"
+
+// Motion profiles: the tuning values that used to be compile-time constants,
+// stored as a versioned, CRC-checked block in EEPROM and switched at runtime
+// with the UP+DOWN chord. The control loop reads only motion(), a set of
+// tables derived from the active profile and rebuilt on first use after a switch.
+
+const uint16_t CONFIG_MAGIC = 0x5243;  // "RC"
+// Bump the low nibble when MotionProfile changes; the block is then reseeded. The
+// axis count sits in the high nibble, so a block from another ARM_AXES build is reseeded too.
+const uint8_t CONFIG_VERSION = 1 + 16 * (ARM_AXES - 3);
+const uint8_t NUM_PROFILES = 3;
+const uint8_t PROFILE_NAME_LEN = 16;   // Including the terminator
+const uint8_t NUM_DIRECTIONS = 8;
+
+struct MotionProfile {
+    char    name[PROFILE_NAME_LEN];
+    float   deadzone;             // 遥感死区大小(0-1)
+    float   joystickSensitivity;  // 遥感速率控制灵敏度
+    uint8_t angleStep;            // 按钮控制的舵机角度步长
+    uint8_t debounceMs;           // 按钮消抖时间
+    uint8_t minAngle[ARM_AXES];   // 每个舵机的角度范围限制
+    uint8_t maxAngle[ARM_AXES];
+    uint8_t center[ARM_AXES];     // 舵机中立位置 (回中按钮, soft start)
+    uint8_t directions[NUM_DIRECTIONS][ARM_STEERED_AXES]; // Joystick targets: up, then clockwise every 45 deg
+};
+
+struct ConfigHeader {
+    uint16_t magic;
+    uint8_t  version;
+    uint8_t  numProfiles;
+    uint16_t crc;                 // CRC-16/CCITT over the profiles
+};
+
+// Precomputed from the active profile so the hot path does no per-tick conversions
+struct MotionTables {
+    float deadzoneStrength;       // deadzone in joystickPolar() strength units (0-100)
+    float strengthScale;          // 1 / (100 - deadzoneStrength)
+    float sensitivity;
+    float angleStep;
+    unsigned long debounceMs;
+    float minAngle[ARM_AXES];
+    float maxAngle[ARM_AXES];
+    float center[ARM_AXES];
+    uint8_t directions[NUM_DIRECTIONS][ARM_STEERED_AXES];
+};
+
+extern MotionTables motionTables;
+extern bool motionTablesStale;
+extern uint8_t configGeneration;  // Incremented on every profile switch, for the display
+
+void rebuildMotionTables();
+
+inline const MotionTables& motion() {
+    if (motionTablesStale) rebuildMotionTables();
+    return motionTables;
+}
+
+void configLoad();                      // Validate the block (reseed if invalid) and restore the selection
+bool configTick();                      // Background EEPROM writes; true if a byte was written this tick
+void configSelectProfile(uint8_t idx);
+void configNextProfile();
+uint8_t configActiveProfile();
+const char* configProfileName();        // Active profile name (RAM copy)
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <Arduino.h>
+#include "flash.h"
+#include "eeprom_layout.h"
+#include "arm.h"
+
+// 定义舵机引脚 (axis order, see arm.h; the first ARM_AXES are used).
+// Pin 13 also drives the LED, which the bootloader blinks at reset, so it goes to the last axis.
+const byte SERVO_PINS[ARM_MAX_AXES] = { 10, 9, 8, A1, 13 };
+
+// 定义遥感引脚
+const byte JOYSTICK_X_PIN = A4;  // 遥感X轴
+const byte JOYSTICK_Y_PIN = A5;  // 遥感Y轴
+
+// 定义按钮引脚
+const byte UP_PIN = 12;        // 向上按钮 (物理上的"上"按钮，增加角度)
+const byte DOWN_PIN = 11;      // 向下按钮 (物理上的"下"按钮，减少角度)
+const byte MOS_CONTROL_BUTTON_PIN = 4; // Renamed from RESET_PIN, this is for MOS control
+const byte CENTER_JOY_PIN = A3; // 手动回中按钮 (舵机到预设中心)
+
+// Define MOS管引脚
+const byte MOS_PIN = 3;
+
+// 控制参数 (死区, 灵敏度, 步长, 消抖, 角度范围, 中心点 and the joystick direction table
+// are per motion profile, see config.h)
+const int SERVO_UPDATE_RATE = 05; // 主循环延迟(ms)
+
+// Control tick: control runs once per period, the display gets whatever time is left
+const unsigned long CONTROL_PERIOD_US = SERVO_UPDATE_RATE * 1000UL;
+
+// Boot: servos resume from the pose saved in EEPROM and ramp to the center pose
+const float SOFT_START_DEG_PER_TICK = 0.6f;     // Ramp speed (0.6 deg per 5 ms tick = 120 deg/s)
+const unsigned long POSE_SAVE_IDLE_MS = 2000;   // Arm must be still this long before the pose is saved
+const byte POSE_EEPROM_MAGIC = 0xA7;
+const int POSE_EEPROM_BYTES = ARM_AXES + 2;     // Magic, one byte per axis, checksum
+static_assert(POSE_EEPROM_ADDR + POSE_EEPROM_BYTES <= PROFILE_SELECT_EEPROM_ADDR, "saved pose overflows its EEPROM region");
+
+// Button struct for debouncing
+struct Button {
+  FlashString   name;           // PROGMEM
+  byte          pin;
+  bool          stableState;    // Debounced state
+  bool          lastReading;    // Previous raw reading
+  unsigned long lastChangeTime; // Time of last unstable reading
+  bool          actionTakenOnPress; // Flag to ensure single action for non-continuous buttons
+};
+
+const size_t NUM_BUTTONS = 4;
+extern Button buttons[NUM_BUTTONS];
+
+// 定义基准方向的舵机角度 (遥感用 - 代表全速偏转时的目标方向)
+struct ServoAngles {
+    int angle[ARM_STEERED_AXES];
+};
+
+// 遥感读数变量
+extern int joystickX;
+extern int joystickY;
+
+// 当前舵机角度 (使用浮点数以实现平滑速率控制)
+extern float currentServoPos[ARM_AXES];
+
+extern unsigned long servoCommitCount; // Incremented by every moveServos() call
+extern unsigned long lastServoMoveMs;  // Last time moveServos() changed the pose
+
+// 函数声明
+void controlSetup();  // Pins, saved pose and servo attach
+void controlTick();   // One control period: buttons, joystick, soft start, pose store
+void moveServos(const float pose[ARM_AXES]);       // Limits, workspace guard, commit
+void writeServoOutputs(const float pose[ARM_AXES]); // Hardware write only, no state change
+void moveToCenterPosition();
+void servoAnglesIncrease(); // Renamed for clarity, UP button increases angles
+void servoAnglesDecrease(); // Renamed for clarity, DOWN button decreases angles
+void resetToMinPosition();
+ServoAngles interpolateDirection(float angle);
+bool joystickPolar(int rawX, int rawY, float &angle_deg, float &normalized_strength); // false inside the deadzone
+void mapJoystickToServos();
+void handleButtons();
+void debounceButtons(); // handleButtons() without the actions
+bool buttonHeld(byte pin); // Debounced state
+bool centerChordOpen();    // CENTER held and not acted on yet: UP/DOWN chord rather than step (macro.h)
+bool loadSavedPose();
+void updatePoseStore();
+bool softStartStep();
+bool slewToward(const float target[ARM_AXES], float degPerTick); // Rate-limited step, true while moving
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <stdint.h>
+
+// CRC-16/CCITT (poly 0x1021, start 0xFFFF), bitwise: no table in flash
+inline uint16_t crc16Update(uint16_t crc, uint8_t data) {
+    crc ^= (uint16_t)data << 8;
+    for (uint8_t i = 0; i < 8; ++i) {
+        crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
@@ -0,0 +1,81 @@
+// Generated by tools/gen_digits.py - do not edit by hand.
+// Run-length-encoded seven-segment glyphs, see tools/gen_digits.py for the format.
+#pragma once
+
+#include <Arduino.h>
+
+#define DIGIT_GLYPH_CHARSET "0123456789 -"
+
+// 12x16, 360 bytes
+const uint8_t DIGITS_12X16_WIDTH = 12;
+const uint8_t DIGITS_12X16_HEIGHT = 16;
+const uint16_t DIGITS_12X16_OFFSETS[] PROGMEM = { 0, 49, 78, 107, 136, 177, 206, 243, 272, 317, 354, 355, 360 };
+const uint8_t DIGITS_12X16_DATA[] PROGMEM = {
+    13, 10, 2, 10, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2,
+    2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2,
+    2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 10, 2, 10,
+    13, 21, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10,
+    2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 13, 13, 10,
+    3, 9, 10, 2, 10, 2, 10, 2, 10, 2, 2, 10, 2, 10, 2, 2,
+    10, 2, 10, 2, 10, 2, 10, 9, 3, 10, 13, 13, 10, 3, 9, 10,
+    2, 10, 2, 10, 2, 10, 2, 2, 10, 2, 10, 10, 2, 10, 2, 10,
+    2, 10, 2, 3, 9, 2, 10, 13, 13, 2, 6, 2, 2, 2, 6, 2,
+    2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2,
+    2, 10, 2, 10, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2,
+    13, 13, 10, 2, 9, 3, 2, 10, 2, 10, 2, 10, 2, 10, 10, 2,
+    10, 10, 2, 10, 2, 10, 2, 10, 2, 3, 9, 2, 10, 13, 13, 10,
+    2, 9, 3, 2, 10, 2, 10, 2, 10, 2, 10, 10, 2, 10, 2, 2,
+    6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 10,
+    2, 10, 13, 13, 10, 3, 9, 10, 2, 10, 2, 10, 2, 10, 2, 10,
+    2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 10, 2, 13,
+    13, 10, 2, 10, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2,
+    2, 2, 6, 2, 2, 10, 2, 10, 2, 2, 6, 2, 2, 2, 6, 2,
+    2, 2, 6, 2, 2, 2, 6, 2, 2, 10, 2, 10, 13, 13, 10, 2,
+    10, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6, 2, 2, 2, 6,
+    2, 2, 10, 2, 10, 10, 2, 10, 2, 10, 2, 10, 2, 3, 9, 2,
+    10, 13, 192, 85, 10, 2, 10, 85,
+};
+
+// 16x24, 566 bytes
+const uint8_t DIGITS_16X24_WIDTH = 16;
+const uint8_t DIGITS_16X24_HEIGHT = 24;
+const uint16_t DIGITS_16X24_OFFSETS[] PROGMEM = { 0, 77, 122, 167, 212, 277, 322, 381, 426, 499, 558, 561, 566 };
+const uint8_t DIGITS_16X24_DATA[] PROGMEM = {
+    18, 12, 3, 14, 2, 14, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 14, 2, 14, 3, 12, 18, 28, 2, 14,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 2, 18, 18, 12, 3, 14, 3, 13,
+    13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 3, 13,
+    2, 13, 3, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3,
+    13, 13, 3, 14, 3, 12, 18, 18, 12, 3, 14, 3, 13, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 3, 13, 3, 13, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 3, 13, 2,
+    14, 3, 12, 18, 18, 2, 8, 2, 3, 3, 8, 3, 2, 3, 8, 3,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 14, 3, 13,
+    13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3,
+    13, 3, 13, 2, 18, 18, 12, 3, 14, 2, 13, 3, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 13, 4, 13, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 3, 13, 2, 14, 3,
+    12, 18, 18, 12, 3, 14, 2, 13, 3, 3, 13, 3, 13, 3, 13, 3,
+    13, 3, 13, 3, 13, 3, 13, 13, 3, 14, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3,
+    8, 3, 2, 3, 8, 3, 2, 14, 2, 14, 3, 12, 18, 18, 12, 3,
+    14, 3, 13, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 13, 2, 18, 18, 12, 3, 14, 2, 14,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 14, 2, 14,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3,
+    2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 14, 2, 14,
+    3, 12, 18, 18, 12, 3, 14, 2, 14, 2, 3, 8, 3, 2, 3, 8,
+    3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8, 3, 2, 3, 8,
+    3, 2, 3, 8, 3, 2, 14, 3, 13, 13, 3, 13, 3, 13, 3, 13,
+    3, 13, 3, 13, 3, 13, 3, 3, 13, 2, 14, 3, 12, 18, 255, 0,
+    129, 178, 12, 4, 12, 178,
+};
+
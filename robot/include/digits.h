@@ -0,0 +1,39 @@
+#pragma once
+
+#include <Arduino.h>
+#include "display_panel.h"
+
+// Pre-rasterized numeric font stored in PROGMEM (see tools/gen_digits.py)
+struct DigitFont {
+    uint8_t         width;   // Glyph cell width in pixels, includes inter-glyph spacing
+    uint8_t         height;
+    const uint16_t* offsets; // PROGMEM: start of each glyph's runs, plus end sentinel
+    const uint8_t*  data;    // PROGMEM: alternating background/foreground run lengths
+};
+
+extern const DigitFont DIGITS_SMALL; // 12x16
+extern const DigitFont DIGITS_LARGE; // 16x24
+
+const uint8_t NUMERIC_READOUT_MAX_DIGITS = 6;
+
+// Right-aligned fixed-width number that only redraws glyphs that changed
+struct NumericReadout {
+    int16_t          x, y;
+    const DigitFont* font;
+    uint8_t          digits; // Field width in glyphs (<= NUMERIC_READOUT_MAX_DIGITS)
+    uint16_t         fg, bg;
+    char             shown[NUMERIC_READOUT_MAX_DIGITS]; // Glyphs on screen, 0 = never drawn
+};
+
+// Draw one glyph opaquely: one address window, then the runs streamed as color bursts
+void drawDigitGlyph(DisplayPanel &tft, const DigitFont &font, int16_t x, int16_t y,
+                    char c, uint16_t fg, uint16_t bg);
+
+// Forget what is on screen so the next update repaints every glyph
+void readoutInvalidate(NumericReadout &readout);
+
+// True when the value differs from what is on screen
+bool readoutDirty(const NumericReadout &readout, int value);
+
+// Redraw at most maxGlyphs changed glyphs; returns true once the screen shows value
+bool readoutUpdate(DisplayPanel &tft, NumericReadout &readout, int value, uint8_t maxGlyphs);
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include "display_panel.h"   // Pins and the driver behind tft
+#include "flash.h"
+
+#define ST77XX_DARKGREY 0x7BEF // Define a dark grey color (16-bit RGB565)
+
+extern DisplayPanel tft;
+
+// Render task table used by the budgeted scheduler
+typedef bool (*RenderDirtyFn)(uint8_t arg); // True when the task has something to draw
+typedef bool (*RenderStepFn)(uint8_t arg);  // Draws one slice, returns true when the task is complete
+
+struct RenderTask {
+    FlashString   name;       // PROGMEM
+    RenderDirtyFn dirty;
+    RenderStepFn  step;
+    uint8_t       arg;        // Widget index passed to dirty/step
+    uint16_t      costUs;     // Estimated cost of one step (seeded, then learned from measurements)
+    unsigned long lastDoneMs; // When the task last completed, used for staleness priority
+    bool          inProgress; // Yielded mid-draw and must be resumed
+};
+
+extern RenderTask renderTasks[];
+extern const size_t NUM_RENDER_TASKS;
+
+// Time from reset to the end of the first control tick, reported once on serial and TFT
+extern unsigned long timeToFirstControlUs;
+
+void setupDisplay(); // Reset pulse only; the panel is brought up by the scheduler
+bool displayBootStep(); // Advance the panel bring-up, true once the static UI is up
+bool displayReady(); // Bring-up finished, only budgeted render steps remain
+void displayInvalidateAll(); // Forget what is on screen so every widget redraws
+void updateDisplay_cooperative(unsigned long tickStartUs); // Budgeted TFT update, runs inside the control tick
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include "st7789_stepped.h"
+#include "st7789_lean.h"
+
+// TFT wiring (software SPI) and the driver that runs it:
+//
+//   DISPLAY_BACKEND_ADAFRUIT  Adafruit_ST7789 drawing (default)
+//   DISPLAY_BACKEND_LEAN      LeanST7789: same bring-up, but fills, lines, text
+//                             and color bursts go out as single-window port bursts
+//
+// Set with -DDISPLAY_BACKEND=DISPLAY_BACKEND_LEAN (env:uno_lean). Both bring the
+// panel up through SteppedST7789, one init command per scheduler step.
+#define DISPLAY_BACKEND_ADAFRUIT 0
+#define DISPLAY_BACKEND_LEAN     1
+#ifndef DISPLAY_BACKEND
+#define DISPLAY_BACKEND DISPLAY_BACKEND_ADAFRUIT
+#endif
+
+#define TFT_SCLK  7  // SPI Clock
+#define TFT_MOSI  6  // SPI Data (Master Out Slave In)
+#define TFT_CS    5  // Chip select control pin
+#define TFT_DC    2  // Data Command control pin
+#define TFT_RST   A0 // Reset pin
+#define TFT_BL    A2 // Backlight Control Pin (Connect to 5V or 3.3V through a resistor if always on, or to this pin for software control)
+
+static_assert(TFT_SCLK == LEAN_SCLK_PIN && TFT_MOSI == LEAN_MOSI_PIN && TFT_CS == LEAN_CS_PIN && TFT_DC == LEAN_DC_PIN,
+              "LeanST7789 drives fixed PORTD bits; update st7789_lean.h with the wiring");
+
+#if DISPLAY_BACKEND == DISPLAY_BACKEND_LEAN
+typedef LeanST7789 DisplayPanel;
+#else
+typedef SteppedST7789 DisplayPanel;
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+
+// EEPROM map (1 KB on the ATmega328P). Every store owns a fixed region here so
+// they can never overlap; add new regions at the end.
+const int POSE_EEPROM_ADDR = 0;             // ARM_AXES + 2 B: magic, one byte per axis, checksum (control.cpp)
+const int PROFILE_SELECT_EEPROM_ADDR = 8;   // 2 B: active profile index and its complement (config.cpp)
+const int CONFIG_EEPROM_ADDR = 16;          // ConfigHeader + NUM_PROFILES x MotionProfile (config.cpp)
+const int CONFIG_EEPROM_END = 256;
+const int FAULT_LOG_EEPROM_ADDR = 256;      // FaultLog: counts per cause and the last faults (supervisor.cpp)
+const int FAULT_LOG_EEPROM_END = 320;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <Arduino.h>
+#include <string.h>
+
+// Typed access to constant data kept in program memory. On AVR, PROGMEM
+// objects are not mapped into the data address space, so they must be read
+// with LPM (pgm_read_*); these wrappers make that explicit in the type and
+// compile to the same loads as hand-written pgm_read_* calls.
+//
+//   const ServoAngles TABLE[] PROGMEM = { ... };
+//   const Flash<ServoAngles> table(TABLE);
+//   ServoAngles a = table[i];
+//
+//   const char NAME[] PROGMEM = "UP";
+//   FlashString name = asFlash(NAME);   // Print::print() reads it from flash
+
+typedef const __FlashStringHelper* FlashString;
+
+inline FlashString asFlash(const char* progmemStr) {
+    return reinterpret_cast<FlashString>(progmemStr);
+}
+
+inline const char* flashPtr(FlashString s) {
+    return reinterpret_cast<const char*>(s);
+}
+
+inline size_t flashStrlen(FlashString s) {
+    return strlen_P(flashPtr(s));
+}
+
+inline char flashCharAt(FlashString s, size_t i) {
+    return (char)pgm_read_byte(flashPtr(s) + i);
+}
+
+// Generic read copies the object out of flash; scalars use a single LPM load
+template <typename T>
+inline T flashRead(const T* p) {
+    T value;
+    memcpy_P(&value, p, sizeof(T));
+    return value;
+}
+
+template <> inline uint8_t  flashRead(const uint8_t* p)  { return pgm_read_byte(p); }
+template <> inline int8_t   flashRead(const int8_t* p)   { return (int8_t)pgm_read_byte(p); }
+template <> inline char     flashRead(const char* p)     { return (char)pgm_read_byte(p); }
+template <> inline uint16_t flashRead(const uint16_t* p) { return pgm_read_word(p); }
+template <> inline int16_t  flashRead(const int16_t* p)  { return (int16_t)pgm_read_word(p); }
+template <> inline uint32_t flashRead(const uint32_t* p) { return pgm_read_dword(p); }
+template <> inline float    flashRead(const float* p)    { return pgm_read_float(p); }
+
+// Read-only view of a PROGMEM array; indexing returns a copy in RAM
+template <typename T>
+class Flash {
+public:
+    explicit Flash(const T* progmemData) : data_(progmemData) {}
+
+    T operator[](size_t i) const { return flashRead(data_ + i); }
+    T operator*() const { return flashRead(data_); }
+
+    // Single member of element i, without copying the whole element out
+    // (C defers the member-pointer type: with M T::* here, Flash<T> would not
+    // compile for scalar T, such as the supervisor's deadline and name tables)
+    template <typename M, typename C = T>
+    M field(size_t i, M C::*member) const { return flashRead(&(data_[i].*member)); }
+
+    const T* ptr() const { return data_; }
+
+private:
+    const T* data_;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Multi-drop master/slave link over the hardware UART. The master broadcasts
+// the pose its control tick produced; every unit, the master included, applies
+// it LINK_APPLY_DELAY_TICKS later, at the same instant on the master's clock.
+// Slaves estimate the master's clock from the frame timestamps and lock their
+// control tick to the master's, so moves start within about one byte time plus
+// resonator drift over a heartbeat period of each other.
+//
+// Frame: SOF addr type seq len ts[4] payload[len] crc[2]
+//   ts  = master micros() when the SOF byte starts on the wire
+//   crc = CRC-16/CCITT over addr..payload
+// Slaves never transmit, so their TX lines may stay unconnected.
+//
+// The role is fixed at build time: -DLINK_ROLE=LINK_MASTER or LINK_SLAVE,
+// -DLINK_ADDRESS=<1..254> (see the uno_master / uno_slave environments).
+
+#define LINK_NONE   0
+#define LINK_MASTER 1
+#define LINK_SLAVE  2
+
+#ifndef LINK_ROLE
+#define LINK_ROLE LINK_NONE
+#endif
+#ifndef LINK_ADDRESS
+#define LINK_ADDRESS 1
+#endif
+
+const bool LINK_ENABLED = LINK_ROLE != LINK_NONE;
+const unsigned long LINK_BAUD = 115200;
+const unsigned long LINK_BYTE_US = 10000000UL / LINK_BAUD;  // 8N1
+const uint8_t LINK_BROADCAST = 0xFF;
+const uint8_t LINK_SOF = 0x7E;
+const uint8_t LINK_MAX_PAYLOAD = 16;
+const uint8_t LINK_APPLY_DELAY_TICKS = 3;     // Covers a frame on the wire plus a late poll
+const unsigned long LINK_HEARTBEAT_MS = 100;  // Unchanged pose is resent this often to keep clocks synced
+const uint8_t LINK_SYNC_WINDOW = 8;           // Clock offset = best of the last N frames
+
+enum LinkFrameType {
+    LINK_FRAME_POSE = 1  // payload: master tick start (4), one angle per axis in centidegrees (ARM_AXES x 2)
+};
+
+struct LinkStats {
+    unsigned long framesSent;
+    unsigned long framesReceived;
+    unsigned long crcErrors;
+    unsigned long seqGaps;
+    unsigned long lateApplies;  // Pose arrived after its apply time and was applied at once
+    long offsetUs;              // Master clock minus local clock
+    bool synced;
+};
+
+extern LinkStats linkStats;
+
+#if LINK_ROLE != LINK_NONE
+
+void linkPoll();                                  // Parse received bytes; call on every loop() pass
+void linkApplyDue();                              // Start of the control tick: write poses that are due
+void linkPublishPose();                           // Master, end of the control tick: broadcast and queue the pose
+long linkPhaseCorrectionUs(unsigned long tickStartUs); // Slave: shift for the tick grid, 0 on the master
+void linkRamp();                                  // Slave: ramp onto the master's pose again (safe state)
+
+#else
+
+inline void linkPoll() {}
+inline void linkApplyDue() {}
+inline void linkPublishPose() {}
+inline long linkPhaseCorrectionUs(unsigned long) { return 0; }
+inline void linkRamp() {}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <Arduino.h>
+#include "flash.h"
+#include "arm.h"
+
+// Macro engine: pre-planned multi-waypoint moves, started by a button chord or a
+// joystick flick and run one step per control tick through moveServos(), so
+// joint limits, the workspace guard and the link see them like any other move.
+//
+//   Chords: hold CENTER, press UP or DOWN within CHORD_WINDOW_MS. CENTER is the
+//           chord modifier, so its own jump to the center pose waits for the
+//           window: it happens once the window has passed with CENTER still held,
+//           or on an earlier release, and not at all if a chord was used. UP/DOWN
+//           do not step while the window is open, nor while still held after
+//           firing a chord, whichever of the chord buttons is released first.
+//   Flicks: a near-full joystick deflection that is back in the deadzone within
+//           FLICK_MAX_MS, classified by the direction of its peak (up, right,
+//           down, left, as in the joystick direction table).
+//
+// Any input while a macro runs (a new button press, or the joystick leaving the
+// deadzone) cancels it where it stands; that input then acts as usual.
+
+enum MacroTrigger : uint8_t {
+    TRIGGER_NONE,
+    TRIGGER_CENTER_UP,
+    TRIGGER_CENTER_DOWN,
+    TRIGGER_FLICK_UP,
+    TRIGGER_FLICK_RIGHT,
+    TRIGGER_FLICK_DOWN,
+    TRIGGER_FLICK_LEFT
+};
+
+enum MacroOp : uint8_t {
+    MACRO_END,
+    MACRO_MOVE,    // Coordinated move to pose: all axes arrive together, arg = speed in 0.1 deg per tick
+    MACRO_MAGNET,  // arg = MOS_PIN level
+    MACRO_WAIT     // arg = time in 10 ms units
+};
+
+const uint8_t MACRO_KEEP = 0xFF;  // Pose value: leave this axis where it is
+const uint8_t MACRO_MAX_STEPS = 8;
+const uint8_t MACRO_NAME_LEN = 12; // Including the terminator
+
+const float FLICK_MIN_STRENGTH = 0.9f;  // Peak normalized strength (see joystickPolar())
+const unsigned long FLICK_MAX_MS = 200; // Out of the deadzone and back within this time
+const unsigned long CHORD_WINDOW_MS = 250; // After CENTER goes down; a tap centers on release
+
+struct MacroStep {
+    uint8_t op;       // MacroOp
+    uint8_t arg;
+    uint8_t pose[ARM_STEERED_AXES]; // MACRO_MOVE only; servo angles or MACRO_KEEP. Other axes hold.
+};
+
+struct Macro {
+    char         name[MACRO_NAME_LEN];
+    uint8_t      trigger;  // MacroTrigger
+    MacroStep    steps[MACRO_MAX_STEPS]; // Ends at the first MACRO_END
+};
+
+extern uint8_t macroGeneration; // Incremented whenever a macro starts or stops, for the display
+
+void macroTick();        // After handleButtons() and mapJoystickToServos(): gestures, cancel, next step
+void macroCancel();
+bool macroRunning();
+FlashString macroName(); // Running macro (PROGMEM), or the last one that ran
+bool macroChordUsed();   // A chord fired since CENTER went down; CENTER then skips its own action
+bool macroChordLatched(byte pin); // The button fired a chord and is still held: it does not step
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Runtime RAM watch: the free RAM between the end of static data/heap and the
+// stack is painted with MEMWATCH_PAINT before main() runs, so the deepest
+// stack excursion since boot can be measured by finding the first byte that
+// was overwritten. Host builds report zeros.
+
+const uint8_t MEMWATCH_PAINT = 0xC5;
+const unsigned long MEMWATCH_REPORT_MS = 10000; // Serial report period
+const uint8_t MEMWATCH_LINE_MAX = 58;           // memwatchReport() line, CR LF included
+
+uint16_t memwatchStaticBytes(); // .data + .bss
+uint16_t memwatchStackPeak();   // Deepest stack use since boot, in bytes
+uint16_t memwatchMinFree();     // Bytes never touched between heap and stack (low-water mark)
+uint16_t memwatchFreeNow();     // Current gap between heap and stack pointer
+
+void memwatchReport(Print &out);  // One-line summary
+void memwatchUpdate();            // Periodic serial report, call from loop()
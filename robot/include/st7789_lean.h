@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+#include "flash.h"
+#include "st7789_stepped.h"
+
+// Lean ST7789 driver for the software-SPI wiring on PORTD. Panel bring-up
+// (initStep(), setRotation()) stays with SteppedST7789; every primitive drawn
+// after that is one address window and one uninterrupted burst under a single
+// CS assertion, clocked by direct port writes: MOSI with sbi/cbi, SCLK by
+// toggling through PIND. Those are single instructions, so interrupts that
+// touch other PORTD pins (the watchdog dropping the magnet) stay safe.
+// Runs of 0x0000 or 0xFFFF hold MOSI and only toggle the clock.
+//
+// Text is sent as one window per print(), instead of one window per glyph
+// pixel. Each glyph row is read from flash once, then the scanline is walked
+// straight into color runs (which carry on across scanlines) and every run goes
+// out as one burst, so black on white text stays on the clock-only path. Transparent text, line breaks, text that
+// would leave the screen and characters outside printable ASCII fall back to
+// the Adafruit path.
+//
+// Selected with -DDISPLAY_BACKEND=DISPLAY_BACKEND_LEAN (see display_panel.h).
+
+// The SPI lines must sit on these PORTD bits (Uno pins 0-7 are PD0-PD7)
+const uint8_t LEAN_SCLK_PIN = 7;
+const uint8_t LEAN_MOSI_PIN = 6;
+const uint8_t LEAN_CS_PIN   = 5;
+const uint8_t LEAN_DC_PIN   = 2;
+
+const uint8_t LEAN_TEXT_CHARS = 53;   // Longest lean print(): a 320-pixel line at text size 1
+
+class LeanST7789 : public SteppedST7789 {
+public:
+    LeanST7789(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst = -1)
+        : SteppedST7789(cs, dc, mosi, sclk, rst) {}
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override;
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) override;
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) override;
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Adafruit_ST7789::write;
+    size_t print(FlashString s); // Whole string in one window; Print's version writes per character
+    using Adafruit_ST7789::print;
+
+    // Streaming, as used by the gauge spans and digit glyphs. These hide the
+    // Adafruit versions, so callers must hold the panel as a LeanST7789
+    // (DisplayPanel); setAddrWindow() also catches the library's own calls.
+    void startWrite();
+    void endWrite();
+    void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) override;
+    void writeColor(uint16_t color, uint32_t len);
+
+private:
+    bool clip(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const;
+    size_t writeText(const char* text, size_t len, bool inFlash);
+};
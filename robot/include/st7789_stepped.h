@@ -0,0 +1,31 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_ST7789.h>
+
+// ST7789 bring-up in scheduler steps. Adafruit_ST7789::init() sends its command
+// list with delay() after most commands, about 200 ms in one call. Here the
+// same list goes out one command per initStep(); the delay after a command is
+// left to the caller, which polls initDue() and runs other work meanwhile.
+//
+// setRotation() is redone here as well: the library's version reads the window
+// size that only init() records. Offsets are those of the 240x320 panel (none).
+
+const uint16_t ST7789_PANEL_WIDTH = 240;
+const uint16_t ST7789_PANEL_HEIGHT = 320;
+
+class SteppedST7789 : public Adafruit_ST7789 {
+public:
+    SteppedST7789(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst = -1)
+        : Adafruit_ST7789(cs, dc, mosi, sclk, rst) {}
+
+    void initBegin();     // Pins and SPI setup; no command is sent yet
+    bool initDue() const; // The delay after the last command has passed
+    bool initStep();      // Next command, only when due; true once the list is done
+    void setRotation(uint8_t r) override;
+
+private:
+    uint8_t initOffset = 0;       // Next command in ST7789_INIT_P
+    uint8_t initDelayMs = 0;      // Wait after the last command sent
+    unsigned long initSentMs = 0;
+};
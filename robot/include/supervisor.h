@@ -0,0 +1,104 @@
+#pragma once
+
+#include <Arduino.h>
+#include "eeprom_layout.h"
+#include "flash.h"
+
+// Loop supervisor. loop() brackets each of its stages with supervisorBegin()/
+// supervisorEnd(); the supervisor keeps per-stage timing against a deadline,
+// counts control ticks that started late, and escalates in two steps:
+//
+//   - A stage that runs past SUPERVISOR_FAULT_US (the servos got no commands
+//     for that long) is logged as FAULT_OVERRUN and puts the arm in the safe state.
+//   - A stage that never returns stops the hardware watchdog from being fed.
+//     Its interrupt notes the stalled stage and pose in .noinit RAM and, unless
+//     configured to hold it, drops the magnet; the next timeout resets the MCU.
+//     After the reset the note is logged as FAULT_WATCHDOG, the servos resume
+//     from the noted pose and the arm starts in the safe state.
+//
+// Safe state: operator input is ignored and the arm slews to the park pose (the
+// active profile's center) through moveServos(), so joint limits and the
+// workspace guard apply. Once parked, a CENTER press hands control back.
+//
+// Faults are kept in an EEPROM ring (counts per cause plus the last
+// FAULT_LOG_SLOTS records), written one byte per control tick.
+
+// Magnet in the software safe state (overrun park, watchdog interrupt, boot
+// after a watchdog reset): 0 = release (default), 1 = keep it as it was. Set
+// with -DSAFE_STATE_MAGNET_HOLD=1. It does not hold across the reset itself:
+// MOS_PIN is tri-stated from the reset until setup(), and controlSetup()
+// drives it low until supervisorStart() turns a held magnet back on, so the
+// magnet drops for that window whatever this is set to.
+#ifndef SAFE_STATE_MAGNET_HOLD
+#define SAFE_STATE_MAGNET_HOLD 0
+#endif
+
+enum SupervisorStage : uint8_t {
+    STAGE_IDLE,
+    STAGE_LINK,         // linkPoll(), every loop pass
+    STAGE_CONTROL,      // controlTick()
+    STAGE_REPORT,       // Serial reports
+    STAGE_DISPLAY_BOOT, // Panel bring-up, in budgeted steps like the render tasks
+    STAGE_DISPLAY,      // Budgeted render steps
+    NUM_STAGES
+};
+
+enum FaultCause : uint8_t {
+    FAULT_NONE,
+    FAULT_WATCHDOG,     // Hardware watchdog reset
+    FAULT_OVERRUN,      // A stage ran past SUPERVISOR_FAULT_US
+    NUM_FAULT_CAUSES
+};
+
+const unsigned long SUPERVISOR_FAULT_US = 50000;  // 10 missed control ticks
+const unsigned long SUPERVISOR_REPORT_MS = 10000; // Serial report period
+const uint8_t FAULT_LOG_SLOTS = 8;
+const uint8_t FAULT_LOG_MAGIC = 0x5F;
+
+struct StageStats {
+    unsigned long overruns;   // Runs longer than the stage deadline
+    unsigned long maxUs;      // Longest run since boot
+};
+
+struct SupervisorStats {
+    StageStats stages[NUM_STAGES];
+    unsigned long lateTicks;  // Control ticks that started more than a period late
+    unsigned long maxTickGapUs;
+};
+
+struct FaultRecord {
+    uint8_t  cause;           // FaultCause; anything else marks an unused slot
+    uint8_t  stage;           // SupervisorStage that was running
+    uint16_t uptimeS;         // Seconds since boot when it happened
+};
+
+// EEPROM image; written front to back, so 'next' only advances once the record is in
+struct FaultLog {
+    FaultRecord records[FAULT_LOG_SLOTS];
+    uint16_t counts[NUM_FAULT_CAUSES];  // counts[FAULT_NONE] unused
+    uint8_t  magic;
+    uint8_t  next;            // Slot the next record goes to
+};
+static_assert(FAULT_LOG_EEPROM_ADDR + sizeof(FaultLog) <= FAULT_LOG_EEPROM_END, "fault log overflows its EEPROM region");
+
+extern SupervisorStats supervisorStats;
+extern FaultLog faultLog;     // RAM copy of the EEPROM log
+
+void supervisorSetup();       // Before controlSetup(): load the log, pick up a watchdog note
+bool supervisorRestorePose(); // controlSetup(): true if the pose was restored from a watchdog note
+void supervisorStart();       // After controlSetup(): enter the safe state if needed, arm the watchdog
+
+void supervisorTickStart(unsigned long tickStartUs); // Start of each control tick: tick timing, feed the watchdog
+void supervisorBegin(SupervisorStage stage);
+void supervisorEnd();
+
+void supervisorFault(FaultCause cause, uint8_t stage); // Log the fault and enter the safe state
+bool supervisorSafeState();
+void supervisorSafeStep();    // controlTick() in the safe state: park, then wait for CENTER
+bool faultLogTick();          // Background EEPROM write; true if a byte was written this tick
+
+FlashString faultCauseName(uint8_t cause);
+FlashString supervisorStageName(uint8_t stage);
+unsigned long supervisorOverruns(); // All stages
+void supervisorReport(Print &out); // All at once, for a Print that does not block
+void supervisorUpdate();      // Periodic serial report, one line per call; call from loop()
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <Arduino.h>
+#include "flash.h"
+#include "arm.h"
+
+// Event tracer: timestamped 6-byte records in a RAM ring, cheap enough to stay
+// on in production. Sources: button edges (handleButtons()), joystick samples
+// that moved, servo writes that changed an axis by a whole degree, magnet
+// toggles, render task steps and supervisor faults.
+//
+// A fault freezes the ring so its lead-up survives; the ring sits in .noinit,
+// so it also survives the watchdog reset. Send 't' over serial to dump it: one
+// line per control tick, so the dump never stalls the loop. The dump empties
+// the ring and recording resumes. tools/trace2perfetto.py turns a serial
+// capture into Chrome trace / Perfetto JSON. Link builds own the UART and do
+// not take the command, so nothing could ever unfreeze the ring there: they
+// never freeze it and start each boot empty. Their ring is read from the sim
+// (--trace).
+//
+// Timestamps are timer0 ticks (4 us at 16 MHz), 24 bits: TCNT0 plus the low 16
+// bits of the core's overflow count. They wrap every 67 s; the converter
+// unwraps assuming consecutive records are closer together than that.
+//
+// Cost: traceRecord() is the timer read with interrupts masked, six stores and
+// the index update, about 50 cycles per record by instruction count on AVR.
+// That is several times a handful of cycles, and it has not been measured on
+// target (the trace_record bench row is host-only). The sources are filtered
+// (whole degrees, joystick steps): at the sim's peak of about two records per
+// 5 ms tick that is some 100 cycles, about 0.1% of the tick.
+//
+// Sizing: the ring should hold at least 150 ms before a fault with all three
+// steered axes moving at full speed. Servo records are limited to whole-degree
+// changes, and the sim peaks at about 400 records/s then (joystick_circle),
+// so 64 records fit that target, and typical motion leaves 0.3-0.8 s. That is
+// 384 B of SRAM; the custom_sram_budget check in platformio.ini catches an overflow.
+
+#ifndef TRACE_RECORDS
+#define TRACE_RECORDS 64   // Power of two, at most 128; 0 compiles tracing out. 6 bytes each.
+#endif
+static_assert((TRACE_RECORDS & (TRACE_RECORDS - 1)) == 0 && TRACE_RECORDS <= 128,
+              "TRACE_RECORDS must be a power of two no larger than 128");
+
+// Keep in sync with TAGS in tools/trace2perfetto.py
+enum TraceTag : uint8_t {
+    TRACE_BUTTON,         // value: button index << 8 | stable level (LOW = pressed)
+    TRACE_JOYSTICK,       // value: X >> 2 << 8 | Y >> 2
+    TRACE_SERVO,          // TRACE_SERVO + axis; value: angle written to the servo, in centidegrees (whole degrees)
+    TRACE_MAGNET = TRACE_SERVO + ARM_MAX_AXES, // value: MOS_PIN level
+    TRACE_DISPLAY_BEGIN,  // value: render task index
+    TRACE_DISPLAY_END,    // value: render task index, | 0x100 if the task completed
+    TRACE_FAULT           // value: FaultCause << 8 | SupervisorStage
+};
+
+const uint8_t TRACE_JOY_STEP = 2;      // Joystick change, in X >> 2 / Y >> 2 units, worth a record
+const uint8_t TRACE_MAGIC = 0x7E;
+const unsigned long TRACE_TICK_US = 4; // timer0 tick: clk/64
+
+struct TraceRecord {
+    uint8_t  tag;         // TraceTag
+    uint8_t  tcnt;        // TCNT0
+    uint16_t overflows;   // timer0 overflow count, low 16 bits
+    uint16_t value;
+};
+
+struct TraceState {
+    uint8_t     magic;
+    uint8_t     head;         // Next slot written
+    uint8_t     count;
+    bool        frozen;       // Not recording: after a fault, or while dumping
+    bool        previousBoot; // The records lead up to a watchdog reset
+    TraceRecord ring[TRACE_RECORDS ? TRACE_RECORDS : 1];
+};
+extern TraceState traceState;
+
+#ifdef __AVR__
+extern "C" volatile unsigned long timer0_overflow_count; // Arduino core, wiring.c
+#endif
+
+inline void traceRecord(uint8_t tag, uint16_t value) {
+#if TRACE_RECORDS
+    if (traceState.frozen) return;
+#ifdef __AVR__
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t tcnt = TCNT0;
+    uint16_t overflows = timer0_overflow_count;
+    if ((TIFR0 & _BV(TOV0)) && tcnt < 255) overflows++; // Overflow pending, not yet counted
+    SREG = sreg;
+#else
+    unsigned long ticks = micros() / TRACE_TICK_US;
+    uint8_t tcnt = ticks;
+    uint16_t overflows = ticks >> 8;
+#endif
+    TraceRecord &r = traceState.ring[traceState.head];
+    r.tag = tag;
+    r.tcnt = tcnt;
+    r.overflows = overflows;
+    r.value = value;
+    traceState.head = (traceState.head + 1) & (TRACE_RECORDS - 1);
+    if (traceState.count < TRACE_RECORDS) traceState.count++;
+#endif
+}
+
+void traceSetup(bool keep); // supervisorSetup(): keep = the ring holds the lead-up to a watchdog reset
+void traceFreeze();         // Stop recording until the next dump (not in link builds)
+void traceJoystick(int rawX, int rawY); // Records only when the reading moved by TRACE_JOY_STEP
+void traceSetDisplayNames(FlashString (*name)(uint8_t idx), uint8_t count); // Render task names for the dump
+
+void traceDump(Print &out); // Whole dump at once (host tools)
+void traceTick();           // From loop(): serial command and the paced dump
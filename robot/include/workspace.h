@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Arduino.h>
+#include "arm.h"
+
+// Workspace guard: rejects joint configurations that put the arm into the
+// table or its own base, using the precomputed bitmap in workspace_map.h
+// (tools/gen_workspace.cpp). One PROGMEM bit read per check, so it runs on
+// every servo commit. Only the commanded pose is checked, not the path to
+// it: single-commit jumps (CENTER) rely on the start and end being free.
+// The map covers the steered axes (yaw, shoulder, elbow); axes past them never collide.
+
+extern unsigned long workspaceSlides;  // Commits that were cut short at the boundary
+
+bool workspaceAllowed(float s1, float s2, float s3);
+
+// Move from the current (prev) pose toward the target as far as the guard
+// allows: the whole move if the target is free, otherwise each axis that can
+// move on its own, so the arm slides along the boundary instead of stopping.
+// From a pose already inside the zone, an axis move is kept only if it does
+// not take the arm deeper (cells to the nearest free cell along one axis), so
+// the operator can back out but not push further in.
+void workspaceGuard(const float prev[ARM_AXES], float target[ARM_AXES]);
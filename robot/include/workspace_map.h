@@ -0,0 +1,66 @@
+// Generated by tools/gen_workspace.cpp - do not edit by hand.
+// Forbidden joint-space cells (bit set = pose collides with the table or base).
+// Arm: base 70, upper arm 100, forearm 110 mm; base column r 40 + 5 mm; table clearance 0 mm.
+#pragma once
+
+#include <Arduino.h>
+
+const uint8_t WORKSPACE_CELL_DEG = 10;
+const uint8_t WORKSPACE_CELLS = 19;          // Per axis; cell i covers i*10 +/- 5 deg
+// 1653 of 6859 cells forbidden, 858 bytes; bit index = (c1 * 19 + c2) * 19 + c3, LSB first
+const uint8_t WORKSPACE_MAP[] PROGMEM = {
+    0xFF, 0x7F, 0xF8, 0xFF, 0xC1, 0xFF, 0x01, 0x3E, 0x00, 0xF0, 0x01, 0x80, 0x07, 0x00, 0x3C, 0x00,
+    0xE0, 0x01, 0x00, 0x0F, 0x00, 0x38, 0x00, 0xC0, 0x01, 0x00, 0x0E, 0x00, 0x30, 0x00, 0x80, 0x01,
+    0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x08, 0x00, 0x40, 0x00, 0x00, 0xFE, 0xFF, 0xF0,
+    0xFF, 0x83, 0xFF, 0x03, 0x7C, 0x00, 0xE0, 0x03, 0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0, 0x03, 0x00,
+    0x1E, 0x00, 0x70, 0x00, 0x80, 0x03, 0x00, 0x1C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00,
+    0xC0, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xFC, 0xFF, 0xE1, 0xFF, 0x07, 0xFF,
+    0x07, 0xF8, 0x00, 0xC0, 0x07, 0x00, 0x1E, 0x00, 0xF0, 0x00, 0x80, 0x07, 0x00, 0x3C, 0x00, 0xE0,
+    0x00, 0x00, 0x07, 0x00, 0x38, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x01, 0x00,
+    0x0C, 0x00, 0x20, 0x00, 0x00, 0x01, 0x00, 0xF8, 0xFF, 0xC3, 0xFF, 0x0F, 0xFE, 0x0F, 0xF0, 0x01,
+    0x80, 0x0F, 0x00, 0x3C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0, 0x01, 0x00, 0x0E,
+    0x00, 0x70, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00, 0x40,
+    0x00, 0x00, 0x02, 0x00, 0xF0, 0xFF, 0x87, 0xFF, 0x1F, 0xFC, 0x1F, 0xE0, 0x03, 0x00, 0x1F, 0x00,
+    0x78, 0x00, 0xC0, 0x03, 0x00, 0x1E, 0x00, 0xF0, 0x00, 0x80, 0x03, 0x00, 0x1C, 0x00, 0xE0, 0x00,
+    0x00, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x00, 0x00, 0x04,
+    0x00, 0xE0, 0xFF, 0x0F, 0xFF, 0x3F, 0xF8, 0x3F, 0xC0, 0x07, 0x00, 0x3E, 0x00, 0xF0, 0x00, 0x80,
+    0x07, 0x00, 0x3C, 0x00, 0xE0, 0x01, 0x00, 0x07, 0x00, 0x38, 0x00, 0xC0, 0x01, 0x00, 0x06, 0x00,
+    0x30, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00, 0xC0, 0xFF,
+    0x1F, 0xFE, 0x7F, 0xF0, 0x7F, 0x80, 0x0F, 0x00, 0x7C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x78,
+    0x00, 0xC0, 0x03, 0x00, 0x0E, 0x00, 0x70, 0x00, 0x80, 0x03, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00,
+    0x03, 0x00, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x02, 0x00, 0x10, 0x00, 0x80, 0xFF, 0x3F, 0xFC, 0xFF,
+    0xE0, 0xFF, 0x00, 0x1F, 0x00, 0xF8, 0x00, 0xC0, 0x03, 0x00, 0x1E, 0x00, 0xF0, 0x00, 0x80, 0x07,
+    0x00, 0x1C, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x00, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x30,
+    0x00, 0x80, 0x01, 0x00, 0x04, 0x00, 0x20, 0x00, 0x00, 0xFF, 0x7F, 0xF8, 0xFF, 0xC1, 0xFF, 0x01,
+    0x3E, 0x00, 0xF0, 0x01, 0x80, 0x07, 0x00, 0x3C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x38, 0x00,
+    0xC0, 0x01, 0x00, 0x0E, 0x00, 0x30, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x03,
+    0x00, 0x08, 0x00, 0x40, 0x00, 0x00, 0xFE, 0xFF, 0xF0, 0xFF, 0x83, 0xFF, 0x03, 0x7C, 0x00, 0xE0,
+    0x03, 0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0, 0x03, 0x00, 0x1E, 0x00, 0x70, 0x00, 0x80, 0x03, 0x00,
+    0x1C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00,
+    0x80, 0x00, 0x00, 0xFC, 0xFF, 0xE1, 0xFF, 0x07, 0xFF, 0x07, 0xF8, 0x00, 0xC0, 0x07, 0x00, 0x1E,
+    0x00, 0xF0, 0x00, 0x80, 0x07, 0x00, 0x3C, 0x00, 0xE0, 0x00, 0x00, 0x07, 0x00, 0x38, 0x00, 0xC0,
+    0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00, 0x20, 0x00, 0x00, 0x01, 0x00,
+    0xF8, 0xFF, 0xC3, 0xFF, 0x0F, 0xFE, 0x0F, 0xF0, 0x01, 0x80, 0x0F, 0x00, 0x3C, 0x00, 0xE0, 0x01,
+    0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0, 0x01, 0x00, 0x0E, 0x00, 0x70, 0x00, 0x80, 0x01, 0x00, 0x0C,
+    0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00, 0x40, 0x00, 0x00, 0x02, 0x00, 0xF0, 0xFF, 0x87,
+    0xFF, 0x1F, 0xFC, 0x1F, 0xE0, 0x03, 0x00, 0x1F, 0x00, 0x78, 0x00, 0xC0, 0x03, 0x00, 0x1E, 0x00,
+    0xF0, 0x00, 0x80, 0x03, 0x00, 0x1C, 0x00, 0xE0, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x00,
+    0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x00, 0x00, 0x04, 0x00, 0xE0, 0xFF, 0x0F, 0xFF, 0x3F, 0xF8,
+    0x3F, 0xC0, 0x07, 0x00, 0x3E, 0x00, 0xF0, 0x00, 0x80, 0x07, 0x00, 0x3C, 0x00, 0xE0, 0x01, 0x00,
+    0x07, 0x00, 0x38, 0x00, 0xC0, 0x01, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x01, 0x00, 0x0C, 0x00,
+    0x60, 0x00, 0x00, 0x01, 0x00, 0x08, 0x00, 0xC0, 0xFF, 0x1F, 0xFE, 0x7F, 0xF0, 0x7F, 0x80, 0x0F,
+    0x00, 0x7C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0, 0x03, 0x00, 0x0E, 0x00, 0x70,
+    0x00, 0x80, 0x03, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x00, 0x00,
+    0x02, 0x00, 0x10, 0x00, 0x80, 0xFF, 0x3F, 0xFC, 0xFF, 0xE0, 0xFF, 0x00, 0x1F, 0x00, 0xF8, 0x00,
+    0xC0, 0x03, 0x00, 0x1E, 0x00, 0xF0, 0x00, 0x80, 0x07, 0x00, 0x1C, 0x00, 0xE0, 0x00, 0x00, 0x07,
+    0x00, 0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80, 0x01, 0x00, 0x04, 0x00, 0x20,
+    0x00, 0x00, 0xFF, 0x7F, 0xF8, 0xFF, 0xC1, 0xFF, 0x01, 0x3E, 0x00, 0xF0, 0x01, 0x80, 0x07, 0x00,
+    0x3C, 0x00, 0xE0, 0x01, 0x00, 0x0F, 0x00, 0x38, 0x00, 0xC0, 0x01, 0x00, 0x0E, 0x00, 0x30, 0x00,
+    0x80, 0x01, 0x00, 0x0C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00, 0x08, 0x00, 0x40, 0x00, 0x00, 0xFE,
+    0xFF, 0xF0, 0xFF, 0x83, 0xFF, 0x03, 0x7C, 0x00, 0xE0, 0x03, 0x00, 0x0F, 0x00, 0x78, 0x00, 0xC0,
+    0x03, 0x00, 0x1E, 0x00, 0x70, 0x00, 0x80, 0x03, 0x00, 0x1C, 0x00, 0x60, 0x00, 0x00, 0x03, 0x00,
+    0x18, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x10, 0x00, 0x80, 0x00, 0x00, 0xFC, 0xFF, 0xE1, 0xFF,
+    0x07, 0xFF, 0x07, 0xF8, 0x00, 0xC0, 0x07, 0x00, 0x1E, 0x00, 0xF0, 0x00, 0x80, 0x07, 0x00, 0x3C,
+    0x00, 0xE0, 0x00, 0x00, 0x07, 0x00, 0x38, 0x00, 0xC0, 0x00, 0x00, 0x06, 0x00, 0x30, 0x00, 0x80,
+    0x01, 0x00, 0x0C, 0x00, 0x20, 0x00, 0x00, 0x01, 0x00, 0x00,
+};
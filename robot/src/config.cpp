@@ -0,0 +1,155 @@
+#include <Arduino.h>
+#include <EEPROM.h>
+#include "config.h"
+#include "eeprom_layout.h"
+#include "flash.h"
+#include "crc16.h"
+
+// Factory profiles: seed the EEPROM block whenever it is missing, corrupt or from another CONFIG_VERSION
+const MotionProfile DEFAULT_PROFILES_P[NUM_PROFILES] PROGMEM = {
+    { "Standard", 0.2f, 0.02f, 3, 50,
+      ARM_AXES_INIT(0, 0, 0, 0), ARM_AXES_INIT(180, 180, 180, 180), ARM_AXES_INIT(180, 180, 180, 90),
+      { {180, 0, 60},    // 上 (0度)
+        {180, 0, 0},     // 右上 (45度)
+        {180, 180, 0},   // 右 (90度)
+        {0, 180, 0},     // 右下 (135度)
+        {0, 180, 60},    // 下 (180度)
+        {0, 180, 180},   // 左下 (225度)
+        {20, 10, 180},   // 左 (270度)
+        {180, 0, 180} }  // 左上 (315度)
+    },
+    // Long moves between stations: twice the rate, quicker buttons
+    { "Fast transfer", 0.15f, 0.04f, 5, 30,
+      ARM_AXES_INIT(0, 0, 0, 0), ARM_AXES_INIT(180, 180, 180, 180), ARM_AXES_INIT(180, 180, 180, 90),
+      { {180, 0, 60}, {180, 0, 0}, {180, 180, 0}, {0, 180, 0},
+        {0, 180, 60}, {0, 180, 180}, {20, 10, 180}, {180, 0, 180} }
+    },
+    // Placement: wide deadzone, slow rate, single-degree button steps
+    { "Precise", 0.25f, 0.008f, 1, 50,
+      ARM_AXES_INIT(0, 0, 0, 0), ARM_AXES_INIT(180, 180, 180, 180), ARM_AXES_INIT(180, 180, 180, 90),
+      { {180, 0, 60}, {180, 0, 0}, {180, 180, 0}, {0, 180, 0},
+        {0, 180, 60}, {0, 180, 180}, {20, 10, 180}, {180, 0, 180} }
+    }
+};
+const Flash<MotionProfile> DEFAULT_PROFILES(DEFAULT_PROFILES_P);
+
+const int PROFILES_EEPROM_ADDR = CONFIG_EEPROM_ADDR + sizeof(ConfigHeader);
+const int PROFILES_BYTES = sizeof(MotionProfile) * NUM_PROFILES;
+static_assert(PROFILES_EEPROM_ADDR + PROFILES_BYTES <= CONFIG_EEPROM_END, "profiles overflow their EEPROM region");
+
+MotionTables motionTables;
+bool motionTablesStale = true;
+uint8_t configGeneration = 0;
+
+static uint8_t activeProfile = 0;
+static char activeName[PROFILE_NAME_LEN];
+static bool eepromValid = false;     // While false (seeding), profiles are read from the flash defaults
+static ConfigHeader seedHeader;
+static int seedOffset = -1;          // Next byte of the seed image (profiles, then header); -1 = idle
+static int8_t selectWriteIndex = -1; // Next byte of the saved selection; -1 = idle
+
+static bool blockValid() {
+    ConfigHeader header;
+    EEPROM.get(CONFIG_EEPROM_ADDR, header);
+    if (header.magic != CONFIG_MAGIC || header.version != CONFIG_VERSION || header.numProfiles != NUM_PROFILES) {
+        return false;
+    }
+    uint16_t crc = 0xFFFF;
+    for (int i = 0; i < PROFILES_BYTES; ++i) crc = crc16Update(crc, EEPROM.read(PROFILES_EEPROM_ADDR + i));
+    return crc == header.crc;
+}
+
+static void readProfile(uint8_t idx, MotionProfile &profile) {
+    if (eepromValid) {
+        EEPROM.get(PROFILES_EEPROM_ADDR + idx * (int)sizeof(MotionProfile), profile);
+    } else {
+        profile = DEFAULT_PROFILES[idx];
+    }
+}
+
+void rebuildMotionTables() {
+    MotionProfile p;
+    readProfile(activeProfile, p);
+    memcpy(activeName, p.name, PROFILE_NAME_LEN);
+    activeName[PROFILE_NAME_LEN - 1] = '\0';
+
+    MotionTables &t = motionTables;
+    t.deadzoneStrength = constrain(p.deadzone, 0.0f, 0.95f) * 100.0f;
+    t.strengthScale = 1.0f / (100.0f - t.deadzoneStrength);
+    t.sensitivity = p.joystickSensitivity;
+    t.angleStep = p.angleStep;
+    t.debounceMs = p.debounceMs;
+    for (int i = 0; i < ARM_AXES; ++i) {
+        t.minAngle[i] = p.minAngle[i];
+        t.maxAngle[i] = max(p.maxAngle[i], p.minAngle[i]);
+        t.center[i] = constrain((float)p.center[i], t.minAngle[i], t.maxAngle[i]);
+    }
+    memcpy(t.directions, p.directions, sizeof(t.directions));
+    motionTablesStale = false;
+}
+
+void configLoad() {
+    eepromValid = blockValid();
+    if (!eepromValid) {
+        // Seeded in the background by configTick(); the header goes last so a torn seed stays invalid
+        uint16_t crc = 0xFFFF;
+        for (int i = 0; i < PROFILES_BYTES; ++i) {
+            crc = crc16Update(crc, pgm_read_byte((const uint8_t*)DEFAULT_PROFILES_P + i));
+        }
+        seedHeader.magic = CONFIG_MAGIC;
+        seedHeader.version = CONFIG_VERSION;
+        seedHeader.numProfiles = NUM_PROFILES;
+        seedHeader.crc = crc;
+        seedOffset = 0;
+    }
+    byte saved = EEPROM.read(PROFILE_SELECT_EEPROM_ADDR);
+    bool savedValid = saved < NUM_PROFILES && EEPROM.read(PROFILE_SELECT_EEPROM_ADDR + 1) == (byte)~saved;
+    activeProfile = savedValid ? saved : 0;
+    rebuildMotionTables();
+}
+
+// One EEPROM byte per call, like updatePoseStore(), so a write never stalls the control tick
+bool configTick() {
+    if (seedOffset >= 0) {
+        if (seedOffset < PROFILES_BYTES) {
+            EEPROM.update(PROFILES_EEPROM_ADDR + seedOffset,
+                          pgm_read_byte((const uint8_t*)DEFAULT_PROFILES_P + seedOffset));
+        } else {
+            int i = seedOffset - PROFILES_BYTES;
+            EEPROM.update(CONFIG_EEPROM_ADDR + i, ((const uint8_t*)&seedHeader)[i]);
+        }
+        if (++seedOffset == PROFILES_BYTES + (int)sizeof(ConfigHeader)) {
+            seedOffset = -1;
+            eepromValid = true;
+        }
+        return true;
+    }
+    if (selectWriteIndex >= 0) {
+        byte value = selectWriteIndex == 0 ? activeProfile : (byte)~activeProfile;
+        EEPROM.update(PROFILE_SELECT_EEPROM_ADDR + selectWriteIndex, value);
+        if (++selectWriteIndex == 2) selectWriteIndex = -1;
+        return true;
+    }
+    return false;
+}
+
+void configSelectProfile(uint8_t idx) {
+    if (idx >= NUM_PROFILES || idx == activeProfile) return;
+    activeProfile = idx;
+    motionTablesStale = true;
+    configGeneration++;
+    selectWriteIndex = 0;
+}
+
+void configNextProfile() {
+    configSelectProfile((activeProfile + 1) % NUM_PROFILES);
+}
+
+uint8_t configActiveProfile() {
+    return activeProfile;
+}
+
+const char* configProfileName() {
+    motion(); // The name is refreshed with the tables
+    return activeName;
+}
@@ -0,0 +1,367 @@
+#include <Arduino.h>
+#include <Servo.h>
+#include <EEPROM.h>
+#include "control.h"
+#include "config.h"
+#include "link.h"
+#include "workspace.h"
+#include "supervisor.h"
+#include "macro.h"
+#include "trace.h"
+
+// 遥感读数变量
+int joystickX;
+int joystickY;
+
+// 创建舵机对象
+Servo servos[ARM_AXES];
+
+// 当前舵机角度 (使用浮点数以实现平滑速率控制)
+float currentServoPos[ARM_AXES] = ARM_AXES_INIT(180.0f, 180.0f, 180.0f, 180.0f);
+
+unsigned long servoCommitCount = 0;
+unsigned long lastServoMoveMs = 0;
+
+static bool softStartActive = true;
+
+const char BUTTON_NAME_UP[] PROGMEM       = "UP";
+const char BUTTON_NAME_DOWN[] PROGMEM     = "DOWN";
+const char BUTTON_NAME_MOS_CTRL[] PROGMEM = "MOS_CTRL";
+const char BUTTON_NAME_CENTER[] PROGMEM   = "CENTER";
+
+Button buttons[NUM_BUTTONS] = {
+  { asFlash(BUTTON_NAME_UP),       UP_PIN,         HIGH, HIGH, 0, false },
+  { asFlash(BUTTON_NAME_DOWN),     DOWN_PIN,       HIGH, HIGH, 0, false },
+  { asFlash(BUTTON_NAME_MOS_CTRL), MOS_CONTROL_BUTTON_PIN, HIGH, HIGH, 0, false }, // Changed from "RESET" and RESET_PIN
+  { asFlash(BUTTON_NAME_CENTER),   CENTER_JOY_PIN, HIGH, HIGH, 0, false }
+};
+
+
+void controlSetup() {
+    pinMode(JOYSTICK_X_PIN, INPUT);
+    pinMode(JOYSTICK_Y_PIN, INPUT);
+    
+    pinMode(UP_PIN, INPUT_PULLUP);
+    pinMode(DOWN_PIN, INPUT_PULLUP);
+    pinMode(MOS_CONTROL_BUTTON_PIN, INPUT_PULLUP); // Changed from RESET_PIN
+    pinMode(CENTER_JOY_PIN, INPUT_PULLUP);
+    pinMode(MOS_PIN, OUTPUT); // MOS_PIN setup
+    digitalWrite(MOS_PIN, LOW); // Set initial state for MOS_PIN
+
+    configLoad(); // Motion profile first: limits and center pose come from it
+
+    // Command the last known pose before attaching so the first pulses don't jerk the arm
+    if (supervisorRestorePose()) {
+        if (!LINK_ENABLED) Serial.println(F("Resuming from the pose before the watchdog reset."));
+    } else if (loadSavedPose()) {
+        if (!LINK_ENABLED) Serial.println(F("已恢复上次位置."));
+    }
+    moveServos(currentServoPos);
+    writeServoOutputs(currentServoPos); // The link master defers moveServos() writes
+    for (uint8_t i = 0; i < ARM_AXES; ++i) servos[i].attach(SERVO_PINS[i]);
+    softStartActive = true;
+}
+
+void controlTick() {
+    unsigned long commitsBefore = servoCommitCount;
+    bool safe = supervisorSafeState();
+    if (!safe || LINK_ROLE != LINK_SLAVE) { // A parked slave stops following the master
+        linkApplyDue(); // Poses from the link that are due this tick
+    }
+    if (safe) {
+        macroCancel();
+        linkRamp(); // A slave leaving the safe state ramps back onto the master's pose
+        debounceButtons();
+        supervisorSafeStep(); // Park and wait for CENTER; operator input is ignored
+    } else if (LINK_ROLE != LINK_SLAVE) { // Slaves follow the master, local input is ignored
+        handleButtons();
+        mapJoystickToServos();
+        macroTick(); // Chords and flicks from this tick's input, then the running macro's next step
+    }
+    if (softStartActive) {
+        // Any operator input takes over from the ramp
+        softStartActive = servoCommitCount == commitsBefore && softStartStep();
+    }
+    if (!faultLogTick() && !configTick()) updatePoseStore(); // At most one EEPROM byte per tick
+    linkPublishPose();
+}
+
+// Read the pose saved by updatePoseStore(); returns false (defaults kept) if invalid
+bool loadSavedPose() {
+    byte pose[ARM_AXES];
+    byte check = POSE_EEPROM_MAGIC;
+    for (uint8_t i = 0; i < ARM_AXES; ++i) {
+        pose[i] = EEPROM.read(POSE_EEPROM_ADDR + 1 + i);
+        check ^= pose[i];
+    }
+    if (EEPROM.read(POSE_EEPROM_ADDR) != POSE_EEPROM_MAGIC ||
+        EEPROM.read(POSE_EEPROM_ADDR + 1 + ARM_AXES) != check) {
+        return false;
+    }
+    for (uint8_t i = 0; i < ARM_AXES; ++i) currentServoPos[i] = pose[i];
+    return true;
+}
+
+// Once the arm has been still for POSE_SAVE_IDLE_MS, write the pose one byte per tick.
+// EEPROM.update() only waits for the previous byte, which a 5 ms tick always covers.
+void updatePoseStore() {
+    static byte pending[POSE_EEPROM_BYTES];
+    static int8_t writeIndex = -1; // -1 = idle
+    static byte saved[ARM_AXES] = ARM_AXES_INIT(0xFF, 0xFF, 0xFF, 0xFF);
+
+    if (writeIndex >= 0) {
+        EEPROM.update(POSE_EEPROM_ADDR + writeIndex, pending[writeIndex]);
+        if (++writeIndex == sizeof(pending)) writeIndex = -1;
+        return;
+    }
+    if (millis() - lastServoMoveMs < POSE_SAVE_IDLE_MS) return;
+
+    byte pose[ARM_AXES];
+    byte check = POSE_EEPROM_MAGIC;
+    for (uint8_t i = 0; i < ARM_AXES; ++i) {
+        pose[i] = round(currentServoPos[i]);
+        check ^= pose[i];
+    }
+    if (memcmp(pose, saved, sizeof(pose)) == 0) return;
+    memcpy(saved, pose, sizeof(pose));
+    pending[0] = POSE_EEPROM_MAGIC;
+    memcpy(&pending[1], pose, sizeof(pose));
+    pending[1 + ARM_AXES] = check; // Written last: a torn save reads as invalid
+    writeIndex = 0;
+}
+
+// Slew toward the center pose; returns true while the ramp is still running
+bool softStartStep() {
+    return slewToward(motion().center, SOFT_START_DEG_PER_TICK);
+}
+
+// One rate-limited step toward target; returns true while still moving
+bool slewToward(const float target[ARM_AXES], float degPerTick) {
+    float pose[ARM_AXES];
+    bool moving = armSlew<ARM_AXES>(currentServoPos, target, degPerTick, pose);
+    if (moving) moveServos(pose);
+    return moving;
+}
+
+// Servo and Button logic functions (existing - ensure they are complete)
+ServoAngles interpolateDirection(float angle) {
+    int baseSector = (int)(angle / 45.0f);
+    if (baseSector < 0) baseSector = 0; 
+    if (baseSector > 7) baseSector = 7;
+    int nextSector = (baseSector + 1) % 8;
+    float blend = (angle - (baseSector * 45.0f)) / 45.0f;
+    if (blend < 0.0f) blend = 0.0f; 
+    if (blend > 1.0f) blend = 1.0f;
+
+    ServoAngles result;
+    armBlend<ARM_STEERED_AXES>(motion().directions[baseSector], motion().directions[nextSector], blend, result.angle);
+    return result;
+}
+
+// Store one committed axis
+struct ServoCommit {
+    const float* target;
+    bool moved;
+    ARM_INLINE void operator()(uint8_t i) {
+        if (target[i] == currentServoPos[i]) return;
+        currentServoPos[i] = target[i];
+        moved = true;
+    }
+};
+
+void moveServos(const float pose[ARM_AXES]) {
+    const MotionTables &m = motion();
+    float target[ARM_AXES];
+    armClamp<ARM_AXES>(pose, m.minAngle, m.maxAngle, target);
+    workspaceGuard(currentServoPos, target); // Joint limits first, then the table/base envelope
+    ServoCommit commit = { target, false };
+    ArmUnroll<ARM_AXES>::run(commit);
+    servoCommitCount++;
+    if (commit.moved) {
+        lastServoMoveMs = millis();
+    }
+    
+    if (LINK_ROLE != LINK_MASTER) { // The master writes its pose when the link applies it
+        writeServoOutputs(currentServoPos);
+    }
+    
+    // "舵机目标(float): " is 21 bytes in UTF-8, then "180.00, " per axis, CR LF included
+    const uint8_t SERVO_DEBUG_LINE_MAX = 21 + 8 * ARM_AXES;
+    static unsigned long lastServoDebugTime = 0;
+    if (!LINK_ENABLED && millis() - lastServoDebugTime > 200 && // Text would share the link UART
+        Serial.availableForWrite() >= SERVO_DEBUG_LINE_MAX) {   // A full TX buffer would stall the tick
+        Serial.print(F("舵机目标(float): "));
+        for (uint8_t i = 0; i < ARM_AXES; ++i) {
+            if (i > 0) Serial.print(F(", "));
+            Serial.print(currentServoPos[i], 2);
+        }
+        Serial.println();
+        lastServoDebugTime = millis();
+    }
+}
+
+// Traced per whole degree the servo is sent, from the integer it gets anyway
+void writeServoOutputs(const float pose[ARM_AXES]) {
+    static int16_t tracedDeg[ARM_AXES] = ARM_AXES_INIT(-1, -1, -1, -1);
+    for (uint8_t i = 0; i < ARM_AXES; ++i) {
+        int16_t deg = round(pose[i]);
+        servos[i].write(deg);
+        if (deg != tracedDeg[i]) {
+            tracedDeg[i] = deg;
+            traceRecord(TRACE_SERVO + i, deg * 100);
+        }
+    }
+}
+
+void moveToCenterPosition() {
+    moveServos(motion().center);
+}
+
+void servoAnglesIncrease() {
+    float pose[ARM_AXES];
+    armOffset<ARM_AXES>(currentServoPos, motion().angleStep, pose);
+    moveServos(pose);
+}
+
+void servoAnglesDecrease() {
+    float pose[ARM_AXES];
+    armOffset<ARM_AXES>(currentServoPos, -motion().angleStep, pose);
+    moveServos(pose);
+}
+
+void resetToMinPosition() { 
+    moveServos(motion().minAngle);
+    if (!LINK_ENABLED) Serial.println(F("按钮: 已重置到最小角度."));
+}
+
+bool joystickPolar(int rawX, int rawY, float &angle_deg, float &normalized_strength) {
+    float x_mapped = map(rawX, 0, 1023, -100, 100);
+    float y_mapped = map(rawY, 0, 1023, -100, 100);
+    float angle_rad = atan2(y_mapped, x_mapped);
+    angle_deg = angle_rad * 180.0f / PI;
+    if (angle_deg < 0) angle_deg += 360.0f;
+    float strength = sqrt(x_mapped*x_mapped + y_mapped*y_mapped);
+
+    const MotionTables &m = motion();
+    if (strength < m.deadzoneStrength) {
+        return false; 
+    }
+    
+    normalized_strength = (strength - m.deadzoneStrength) * m.strengthScale;
+    normalized_strength = constrain(normalized_strength, 0.0f, 1.0f);
+    return true;
+}
+
+void mapJoystickToServos() {
+    joystickX = analogRead(JOYSTICK_X_PIN);
+    joystickY = analogRead(JOYSTICK_Y_PIN);
+    traceJoystick(joystickX, joystickY);
+    float angle_deg, normalized_strength;
+    if (!joystickPolar(joystickX, joystickY, angle_deg, normalized_strength)) {
+        return;
+    }
+
+    ServoAngles targetDirectionPos = interpolateDirection(angle_deg);
+
+    float rate = normalized_strength * motion().sensitivity;
+    float pose[ARM_AXES];
+    armApproach<ARM_STEERED_AXES>(currentServoPos, targetDirectionPos.angle, rate, pose);
+    armCopy<ARM_AXES, ARM_STEERED_AXES>(currentServoPos, pose); // Axes past the direction table hold
+    moveServos(pose);
+}
+
+bool buttonHeld(byte pin) {
+  for (const auto &btn : buttons) {
+    if (btn.pin == pin) return btn.stableState == LOW;
+  }
+  return false;
+}
+
+static bool centerActed = false; // CENTER centered the arm during this press
+
+bool centerChordOpen() {
+  for (const auto &btn : buttons) {
+    if (btn.pin == CENTER_JOY_PIN) return btn.stableState == LOW && !centerActed;
+  }
+  return false;
+}
+
+static void debounceButton(Button &btn, unsigned long now, unsigned long debounceMs) {
+  bool reading = digitalRead(btn.pin);
+  if (reading != btn.lastReading) {
+    btn.lastReading = reading;
+    btn.lastChangeTime = now;
+  }
+  if ((now - btn.lastChangeTime) >= debounceMs && reading != btn.stableState) {
+    btn.stableState = reading;
+    traceRecord(TRACE_BUTTON, (uint16_t)(&btn - buttons) << 8 | reading);
+  }
+}
+
+// Debounce only, no actions: the safe state reads CENTER through buttonHeld()
+void debounceButtons() {
+  unsigned long now = millis();
+  unsigned long debounceMs = motion().debounceMs;
+  for (auto &btn : buttons) debounceButton(btn, now, debounceMs);
+}
+
+void handleButtons() {
+  unsigned long now = millis();
+  unsigned long debounceMs = motion().debounceMs;
+
+  // UP+DOWN chord selects the next motion profile, once per chord; the UP/DOWN
+  // steps stay suppressed until both buttons are released
+  static bool chordHeld = false;
+  bool upHeld = buttonHeld(UP_PIN);
+  bool downHeld = buttonHeld(DOWN_PIN);
+  bool chordOpen = centerChordOpen(); // Macro chord modifier (macro.h): UP/DOWN don't step
+  if (upHeld && downHeld && !chordHeld) {
+    chordHeld = true;
+    configNextProfile();
+    if (!LINK_ENABLED) {
+      Serial.print(F("Profile: "));
+      Serial.println(configProfileName());
+    }
+    moveServos(currentServoPos); // Clamp into the new limits
+  } else if (!upHeld && !downHeld) {
+    chordHeld = false;
+  }
+
+  for (auto &btn : buttons) {
+    debounceButton(btn, now, debounceMs);
+
+    if (btn.stableState == LOW) { 
+        if (btn.pin == UP_PIN) {
+          if (!chordHeld && !chordOpen && !macroChordLatched(UP_PIN)) servoAnglesIncrease();
+        } else if (btn.pin == DOWN_PIN) {
+          if (!chordHeld && !chordOpen && !macroChordLatched(DOWN_PIN)) servoAnglesDecrease();
+        } else if (btn.pin == MOS_CONTROL_BUTTON_PIN) { 
+          if (!btn.actionTakenOnPress) {
+            bool currentMosState = digitalRead(MOS_PIN);
+            bool newMosState = !currentMosState;
+            digitalWrite(MOS_PIN, newMosState);
+            traceRecord(TRACE_MAGNET, newMosState);
+            if (!LINK_ENABLED) {
+              Serial.print(F("MOS_PIN (Pin 3) is now: "));
+              Serial.println(newMosState ? F("HIGH") : F("LOW"));
+            }
+            btn.actionTakenOnPress = true;
+          }
+        } else if (btn.pin == CENTER_JOY_PIN) {
+          // CENTER doubles as the macro chord modifier: it centers once the chord
+          // window has passed without a chord, or on an earlier release (below)
+          btn.actionTakenOnPress = true;
+          if (!centerActed && !macroChordUsed() && now - btn.lastChangeTime >= CHORD_WINDOW_MS) {
+            moveToCenterPosition();
+            centerActed = true;
+          }
+        }
+      } else { 
+          if (btn.pin == CENTER_JOY_PIN) {
+            if (btn.actionTakenOnPress && !centerActed && !macroChordUsed()) moveToCenterPosition();
+            centerActed = false;
+          }
+          btn.actionTakenOnPress = false;
+      } 
+  }
+}
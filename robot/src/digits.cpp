@@ -0,0 +1,78 @@
+#include "digits.h"
+#include "digit_glyphs.h"
+
+const DigitFont DIGITS_SMALL = { DIGITS_12X16_WIDTH, DIGITS_12X16_HEIGHT, DIGITS_12X16_OFFSETS, DIGITS_12X16_DATA };
+const DigitFont DIGITS_LARGE = { DIGITS_16X24_WIDTH, DIGITS_16X24_HEIGHT, DIGITS_16X24_OFFSETS, DIGITS_16X24_DATA };
+
+static uint8_t glyphIndex(char c) {
+    const char* charset = DIGIT_GLYPH_CHARSET;
+    const char* pos = c ? strchr(charset, c) : NULL;
+    if (pos == NULL) pos = strchr(charset, ' '); // Unknown characters render blank
+    return pos - charset;
+}
+
+void drawDigitGlyph(DisplayPanel &tft, const DigitFont &font, int16_t x, int16_t y,
+                    char c, uint16_t fg, uint16_t bg) {
+    uint8_t idx = glyphIndex(c);
+    uint16_t start = pgm_read_word(&font.offsets[idx]);
+    uint16_t end = pgm_read_word(&font.offsets[idx + 1]);
+
+    tft.startWrite();
+    tft.setAddrWindow(x, y, font.width, font.height);
+    bool foreground = false; // Runs alternate, starting with background
+    for (uint16_t i = start; i < end; ++i) {
+        uint8_t run = pgm_read_byte(&font.data[i]);
+        if (run) tft.writeColor(foreground ? fg : bg, run);
+        foreground = !foreground;
+    }
+    tft.endWrite();
+}
+
+// Right-align value in digits glyphs; a value that does not fit shows all dashes
+static void formatReadout(int value, uint8_t digits, char* out) {
+    bool negative = value < 0;
+    unsigned int magnitude = negative ? -(long)value : value;
+    int8_t pos = digits - 1;
+    do {
+        if (pos < 0) {
+            memset(out, '-', digits);
+            return;
+        }
+        out[pos--] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    if (negative) {
+        if (pos < 0) {
+            memset(out, '-', digits);
+            return;
+        }
+        out[pos--] = '-';
+    }
+    while (pos >= 0) out[pos--] = ' ';
+}
+
+void readoutInvalidate(NumericReadout &readout) {
+    memset(readout.shown, 0, sizeof(readout.shown));
+}
+
+bool readoutDirty(const NumericReadout &readout, int value) {
+    char text[NUMERIC_READOUT_MAX_DIGITS];
+    formatReadout(value, readout.digits, text);
+    return memcmp(text, readout.shown, readout.digits) != 0;
+}
+
+bool readoutUpdate(DisplayPanel &tft, NumericReadout &readout, int value, uint8_t maxGlyphs) {
+    char text[NUMERIC_READOUT_MAX_DIGITS];
+    formatReadout(value, readout.digits, text);
+
+    uint8_t drawn = 0;
+    for (uint8_t i = 0; i < readout.digits; ++i) {
+        if (text[i] == readout.shown[i]) continue;
+        if (drawn == maxGlyphs) return false; // Budget used up, more glyphs pending
+        drawDigitGlyph(tft, *readout.font, readout.x + i * readout.font->width, readout.y,
+                       text[i], readout.fg, readout.bg);
+        readout.shown[i] = text[i];
+        ++drawn;
+    }
+    return true;
+}
@@ -0,0 +1,680 @@
+#include <Arduino.h>
+#include <Adafruit_GFX.h>    // Core graphics library
+#include <Adafruit_ST7789.h> // Hardware-specific library for ST7789
+#include <SPI.h>             // Included for completeness, software SPI is used
+#include "control.h"
+#include "display.h"
+#include "digits.h"          // RLE digit glyphs for numeric readouts
+#include "memwatch.h"        // Stack high-water mark
+#include "flash.h"
+#include "config.h"          // Active motion profile name
+#include "link.h"            // LINK_ENABLED: no text on the link UART
+#include "supervisor.h"      // Loop overruns and the safe state
+#include "macro.h"           // Running macro
+#include "trace.h"           // Render steps in the event trace
+
+// Initialize the ST7789 driver object for software SPI (pins in display_panel.h).
+// RST is passed as -1: the library's reset sequence blocks for 400 ms, so setup()
+// pulses TFT_RST itself and the panel recovers while the control loop starts.
+DisplayPanel tft = DisplayPanel(TFT_CS, TFT_DC, TFT_MOSI, TFT_SCLK, -1);
+
+const unsigned long TFT_RESET_RECOVERY_MS = 5;  // ST7789 needs 5 ms after a reset pulse before commands
+
+const unsigned long DISPLAY_BUDGET_MARGIN_US = 300; // Slack kept for loop overhead and estimate error
+const uint16_t RENDER_STEP_COST_CAP_US = 2000;      // Learned costs never exceed this, so one slow step doesn't pin the estimate
+// The remaining budget can be below the cap (a long control tick), so a task can still
+// go on not fitting: once no step has run for this many ticks in a row, the stalest
+// task runs regardless of its cost
+const uint8_t RENDER_STARVE_TICKS = 8;
+const int RENDER_STRIP_ROWS = 4;                    // Rows filled per step when a rectangle fill yields
+
+// Variables for display state and selective updates
+int prev_joystickX_display = -1;
+int prev_joystickY_display = -1;
+bool joy_box_drawn = false;
+
+// Numeric readouts: joystick next to its box, servo angles along the bottom edge
+NumericReadout joyReadouts[2] = {
+    { 72, 42, &DIGITS_SMALL, 4, ST77XX_BLACK, ST77XX_WHITE, {0} },
+    { 72, 66, &DIGITS_SMALL, 4, ST77XX_BLACK, ST77XX_WHITE, {0} }
+};
+NumericReadout servoReadouts[3] = {
+    { 134, 214, &DIGITS_LARGE, 3, ST77XX_BLACK, ST77XX_WHITE, {0} },
+    { 199, 214, &DIGITS_LARGE, 3, ST77XX_BLACK, ST77XX_WHITE, {0} },
+    { 264, 214, &DIGITS_LARGE, 3, ST77XX_BLACK, ST77XX_WHITE, {0} }
+};
+const uint8_t READOUT_GLYPHS_PER_STEP = 2; // Glyphs drawn before a readout task yields
+
+// Button pills are drawn in phases so one redraw never has to fit in a single step
+enum ButtonDrawPhase {
+    BUTTON_PHASE_LABEL, // Clear line and print "NAME:"
+    BUTTON_PHASE_PILL,  // Fill the pill, RENDER_STRIP_ROWS rows per step
+    BUTTON_PHASE_TEXT   // Print ON/OFF inside the pill
+};
+
+struct ButtonWidget {
+    bool            drawn;      // Drawn at least once
+    bool            shownState; // stableState currently on screen (or being drawn)
+    ButtonDrawPhase phase;
+    int             stripRow;
+};
+ButtonWidget buttonWidgets[NUM_BUTTONS];
+
+// Electromagnet status box
+struct MagnetWidget {
+    bool drawn;      // Frame and label drawn
+    bool shownState; // MOS state currently on screen (or being drawn)
+    bool filling;    // Fill in progress
+    int  stripRow;
+};
+MagnetWidget magnetWidget = { false, false, false, 0 };
+
+// Servo angle gauges: horizontal bars, 1 px per degree (0..180). The layout
+// has room for the steered axes only; further axes (arm.h) are not shown.
+const int NUM_SERVO_GAUGES = ARM_STEERED_AXES;
+const int GAUGE_X = 136, GAUGE_Y = 155;
+const int GAUGE_WIDTH = 180, GAUGE_HEIGHT = 12, GAUGE_SPACING = 20;
+const int GAUGE_MAX_SPAN_PX = 45; // Max pixels repainted per gauge update (bounds cost to 45*12 px)
+const uint16_t GAUGE_FILL_COLORS[NUM_SERVO_GAUGES] = { ST77XX_BLUE, ST77XX_MAGENTA, ST77XX_ORANGE };
+int prev_gauge_px[NUM_SERVO_GAUGES] = { -1, -1, -1 }; // Painted fill length, -1 = never drawn
+
+// Static UI is brought up progressively by the scheduler before any widget draws
+enum DisplayBootPhase {
+    BOOT_WAIT_RESET, // Panel recovering from the reset pulse in setup()
+    BOOT_INIT_PANEL, // ST7789 command list, one command per step; its delays pass between steps
+    BOOT_CLEAR,      // Clear to white, BOOT_CLEAR_ROWS rows per step
+    BOOT_BACKLIGHT,  // Backlight on only once the panel holds no garbage
+    BOOT_TITLE,      // Title, one size-2 character per step
+    BOOT_RULE,       // Line under the title
+    BOOT_DONE
+};
+DisplayBootPhase displayBootPhase = BOOT_WAIT_RESET;
+const int BOOT_CLEAR_ROWS = 1;            // 320 px per step over software SPI
+const uint16_t BOOT_STEP_COST_US = 1800;  // Budget required before a boot step is attempted
+const char DISPLAY_TITLE_P[] PROGMEM = "Robot Control";
+const FlashString DISPLAY_TITLE = asFlash(DISPLAY_TITLE_P);
+int bootRow = 0;
+uint8_t bootTitleChar = 0;
+unsigned long tftResetMs = 0;
+static bool bootWaiting = false; // The last boot step only waited: nothing more to do this tick
+
+unsigned long timeToFirstControlUs = 0;
+bool boot_time_drawn = false;
+
+static FlashString renderTaskName(uint8_t idx) {
+    return renderTasks[idx].name;
+}
+
+void setupDisplay() {
+    traceSetDisplayNames(renderTaskName, NUM_RENDER_TASKS);
+  #ifdef TFT_BL
+    pinMode(TFT_BL, OUTPUT);
+    digitalWrite(TFT_BL, LOW); // Dark until the screen is cleared
+  #endif
+
+  // Short hardware reset instead of the library's 400 ms blocking sequence
+  pinMode(TFT_RST, OUTPUT);
+  digitalWrite(TFT_RST, LOW);
+  delayMicroseconds(20);
+  digitalWrite(TFT_RST, HIGH);
+  tftResetMs = millis();
+  displayBootPhase = BOOT_WAIT_RESET;
+}
+
+// Advance the display bring-up by one step; returns true once the static UI is up
+bool displayBootStep() {
+    bootWaiting = false;
+    switch (displayBootPhase) {
+        case BOOT_WAIT_RESET:
+            if (millis() - tftResetMs < TFT_RESET_RECOVERY_MS) {
+                bootWaiting = true;
+                return false;
+            }
+            tft.initBegin();
+            displayBootPhase = BOOT_INIT_PANEL;
+            return false;
+        case BOOT_INIT_PANEL:
+            if (!tft.initDue()) {
+                bootWaiting = true;
+                return false;
+            }
+            if (!tft.initStep()) return false;
+            tft.setRotation(1);
+            tft.setTextSize(1);
+            bootRow = 0;
+            displayBootPhase = BOOT_CLEAR;
+            return false;
+        case BOOT_CLEAR:
+            tft.fillRect(0, bootRow, tft.width(), BOOT_CLEAR_ROWS, ST77XX_WHITE);
+            bootRow += BOOT_CLEAR_ROWS;
+            if (bootRow >= tft.height()) displayBootPhase = BOOT_BACKLIGHT;
+            return false;
+        case BOOT_BACKLIGHT:
+          #ifdef TFT_BL
+            digitalWrite(TFT_BL, HIGH);
+          #endif
+            bootTitleChar = 0;
+            displayBootPhase = BOOT_TITLE;
+            return false;
+        case BOOT_TITLE: {
+            // Centered title; size 2 advances 12 px per character
+            int titleWidth = flashStrlen(DISPLAY_TITLE) * 12 - 2;
+            tft.setTextSize(2);
+            tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+            tft.setCursor((320 - titleWidth) / 2 + bootTitleChar * 12, 5);
+            tft.print(flashCharAt(DISPLAY_TITLE, bootTitleChar));
+            tft.setTextSize(1);
+            if (flashCharAt(DISPLAY_TITLE, ++bootTitleChar) == '\0') displayBootPhase = BOOT_RULE;
+            return false;
+        }
+        case BOOT_RULE:
+            tft.drawFastHLine(10, 25, 300, ST77XX_BLACK);
+            displayBootPhase = BOOT_DONE;
+            if (!LINK_ENABLED) Serial.println(F("LCD Initialized in Landscape Mode."));
+            return true;
+        case BOOT_DONE:
+            return true;
+    }
+    return true;
+}
+
+bool displayReady() {
+    return displayBootPhase == BOOT_DONE;
+}
+
+// Fill the next RENDER_STRIP_ROWS rows of a rectangle; returns true once the last row is done
+bool fillRectStrip(int x, int y, int w, int h, uint16_t color, int &row) {
+    int rows = min(RENDER_STRIP_ROWS, h - row);
+    tft.fillRect(x, y + row, w, rows, color);
+    row += rows;
+    if (row >= h) {
+        row = 0;
+        return true;
+    }
+    return false;
+}
+
+// Width of a string in the built-in 5x7 font at text size 1 (replaces getTextBounds)
+int textWidth1(FlashString text) {
+    return flashStrlen(text) * 6 - 1;
+}
+
+// --- Joystick readouts ---
+bool joyTextDirty(uint8_t axis) {
+    return readoutDirty(joyReadouts[axis], axis == 0 ? joystickX : joystickY);
+}
+
+bool joyTextStep(uint8_t axis) {
+    return readoutUpdate(tft, joyReadouts[axis], axis == 0 ? joystickX : joystickY, READOUT_GLYPHS_PER_STEP);
+}
+
+bool joyBoxDirty(uint8_t) {
+    return !joy_box_drawn;
+}
+
+bool joyBoxStep(uint8_t) {
+    int joyBoxX = 10, joyBoxY = 40, joyBoxSize = 50;
+    tft.drawRect(joyBoxX, joyBoxY, joyBoxSize, joyBoxSize, ST77XX_BLACK);
+    tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+    tft.setCursor(joyReadouts[0].x - 8, joyReadouts[0].y + 4);
+    tft.print('X');
+    tft.setCursor(joyReadouts[1].x - 8, joyReadouts[1].y + 4);
+    tft.print('Y');
+    joy_box_drawn = true;
+    return true;
+}
+
+bool joyDotDirty(uint8_t) {
+    return joystickX != prev_joystickX_display || joystickY != prev_joystickY_display;
+}
+
+bool joyDotStep(uint8_t) {
+    int joyBoxX = 10, joyBoxY = 40, joyBoxSize = 50;
+    if (prev_joystickX_display != -1) {
+        int prev_dotX = map(prev_joystickY_display, 0, 1023, joyBoxX + 2, joyBoxX + joyBoxSize - 3);
+        int prev_dotY = map(prev_joystickX_display, 1023, 0, joyBoxY + 2, joyBoxY + joyBoxSize - 3);
+        tft.fillCircle(prev_dotX, prev_dotY, 3, ST77XX_WHITE);
+    }
+    int current_dotX = map(joystickY, 0, 1023, joyBoxX + 2, joyBoxX + joyBoxSize - 3);
+    int current_dotY = map(joystickX, 1023, 0, joyBoxY + 2, joyBoxY + joyBoxSize - 3);
+    tft.fillCircle(current_dotX, current_dotY, 3, ST77XX_RED);
+    prev_joystickX_display = joystickX;
+    prev_joystickY_display = joystickY;
+    return true;
+}
+
+// --- Button pills ---
+bool buttonDirty(uint8_t idx) {
+    return !buttonWidgets[idx].drawn || buttons[idx].stableState != buttonWidgets[idx].shownState;
+}
+
+bool buttonStep(uint8_t idx) {
+    const int buttonDisplayStartX = 150, buttonDisplayStartY = 40;
+    const int buttonRectHeight = 18, buttonRectWidth = 55, lineSpacing = 25;
+    int currentY = buttonDisplayStartY + (idx * lineSpacing);
+    int rectX = buttonDisplayStartX + 40;
+    ButtonWidget &widget = buttonWidgets[idx];
+
+    // Invert the display logic for pins 4, 11, and 12
+    bool isInvertedButton = (buttons[idx].pin == 4 || 
+                             buttons[idx].pin == 11 || 
+                             buttons[idx].pin == 12);
+    bool displayAsPressed = isInvertedButton ? 
+                            (widget.shownState == HIGH) : 
+                            (widget.shownState == LOW);
+
+    switch (widget.phase) {
+        case BUTTON_PHASE_LABEL:
+            widget.shownState = buttons[idx].stableState; // Latch the state this redraw shows
+            tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+            tft.fillRect(buttonDisplayStartX, currentY, 40, buttonRectHeight, ST77XX_WHITE);
+            tft.setCursor(buttonDisplayStartX, currentY + (buttonRectHeight/2) - 4);
+            tft.print(buttons[idx].name);
+            tft.print(':');
+            widget.stripRow = 0;
+            widget.phase = BUTTON_PHASE_PILL;
+            return false;
+        case BUTTON_PHASE_PILL:
+            if (fillRectStrip(rectX, currentY, buttonRectWidth, buttonRectHeight,
+                              displayAsPressed ? ST77XX_GREEN : ST77XX_DARKGREY, widget.stripRow)) {
+                widget.phase = BUTTON_PHASE_TEXT;
+            }
+            return false;
+        case BUTTON_PHASE_TEXT: {
+            FlashString label = displayAsPressed ? F("ON") : F("OFF");
+            tft.setTextColor(ST77XX_WHITE);
+            tft.setCursor(rectX + (buttonRectWidth - textWidth1(label)) / 2, currentY + (buttonRectHeight - 8) / 2);
+            tft.print(label);
+            widget.drawn = true;
+            widget.phase = BUTTON_PHASE_LABEL;
+            return true;
+        }
+    }
+    return true;
+}
+
+// --- Electromagnet status box ---
+bool magnetDirty(uint8_t) {
+    return !magnetWidget.drawn || (bool)digitalRead(MOS_PIN) != magnetWidget.shownState;
+}
+
+bool magnetStep(uint8_t) {
+    const int statusBoxX = 10, statusBoxY = 150;
+    const int statusBoxWidth = 100, statusBoxHeight = 60;
+
+    if (!magnetWidget.filling) {
+        if (!magnetWidget.drawn) {
+            tft.drawRect(statusBoxX, statusBoxY, statusBoxWidth, statusBoxHeight, ST77XX_BLACK);
+            tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+            tft.setCursor(statusBoxX + 5, statusBoxY + 5);
+            tft.print(F("Magnet:"));
+        }
+        magnetWidget.shownState = digitalRead(MOS_PIN); // Latch the state this redraw shows
+        magnetWidget.stripRow = 0;
+        magnetWidget.filling = true;
+        return false;
+    }
+    if (fillRectStrip(statusBoxX + 5, statusBoxY + 25, statusBoxWidth - 10, statusBoxHeight - 30,
+                      magnetWidget.shownState ? ST77XX_GREEN : ST77XX_RED, magnetWidget.stripRow)) {
+        magnetWidget.filling = false;
+        magnetWidget.drawn = true;
+        return true;
+    }
+    return false;
+}
+
+// --- Servo gauges ---
+// Fill one horizontal span of a gauge bar with a single address window + color burst
+void drawGaugeSpan(int gauge_idx, int from_px, int to_px, uint16_t color) {
+    if (to_px <= from_px) return;
+    int y = GAUGE_Y + gauge_idx * GAUGE_SPACING;
+    tft.startWrite();
+    tft.setAddrWindow(GAUGE_X + from_px, y, to_px - from_px, GAUGE_HEIGHT);
+    tft.writeColor(color, (uint32_t)(to_px - from_px) * GAUGE_HEIGHT);
+    tft.endWrite();
+}
+
+float servoPosForGauge(int gauge_idx) {
+    return currentServoPos[gauge_idx];
+}
+
+int gaugeTargetPx(int gauge_idx) {
+    return constrain((int)round(servoPosForGauge(gauge_idx)), 0, GAUGE_WIDTH);
+}
+
+// Repaint only the delta between the painted and current fill length.
+// At most GAUGE_MAX_SPAN_PX columns per call; the rest follows on later passes.
+void updateServoGauge(int gauge_idx, float servoPos) {
+    int target_px = constrain((int)round(servoPos), 0, GAUGE_WIDTH);
+
+    if (prev_gauge_px[gauge_idx] < 0) { // First draw: label, frame and empty bar
+        int y = GAUGE_Y + gauge_idx * GAUGE_SPACING;
+        tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+        tft.setCursor(GAUGE_X - 16, y + 2);
+        tft.print('S');
+        tft.print(gauge_idx + 1);
+        tft.drawRect(GAUGE_X - 1, y - 1, GAUGE_WIDTH + 2, GAUGE_HEIGHT + 2, ST77XX_BLACK);
+        drawGaugeSpan(gauge_idx, 0, GAUGE_WIDTH, ST77XX_WHITE);
+        prev_gauge_px[gauge_idx] = 0;
+    }
+
+    int painted_px = prev_gauge_px[gauge_idx];
+    if (target_px > painted_px) {
+        int end_px = min(target_px, painted_px + GAUGE_MAX_SPAN_PX);
+        drawGaugeSpan(gauge_idx, painted_px, end_px, GAUGE_FILL_COLORS[gauge_idx]);
+        prev_gauge_px[gauge_idx] = end_px;
+    } else if (target_px < painted_px) {
+        int start_px = max(target_px, painted_px - GAUGE_MAX_SPAN_PX);
+        drawGaugeSpan(gauge_idx, start_px, painted_px, ST77XX_WHITE);
+        prev_gauge_px[gauge_idx] = start_px;
+    }
+}
+
+bool gaugeDirty(uint8_t gauge_idx) {
+    return prev_gauge_px[gauge_idx] != gaugeTargetPx(gauge_idx);
+}
+
+bool gaugeStep(uint8_t gauge_idx) {
+    updateServoGauge(gauge_idx, servoPosForGauge(gauge_idx));
+    return prev_gauge_px[gauge_idx] == gaugeTargetPx(gauge_idx);
+}
+
+// --- Servo angle readouts ---
+bool servoReadoutDirty(uint8_t idx) {
+    return readoutDirty(servoReadouts[idx], (int)round(servoPosForGauge(idx)));
+}
+
+bool servoReadoutStep(uint8_t idx) {
+    NumericReadout &readout = servoReadouts[idx];
+    if (readout.shown[0] == 0) { // First draw: label left of the digits
+        tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+        tft.setCursor(readout.x - 14, readout.y + 8);
+        tft.print('S');
+        tft.print(idx + 1);
+    }
+    return readoutUpdate(tft, readout, (int)round(servoPosForGauge(idx)), READOUT_GLYPHS_PER_STEP);
+}
+
+// --- Boot time report ---
+bool bootTimeDirty(uint8_t) {
+    return !boot_time_drawn && timeToFirstControlUs != 0;
+}
+
+bool bootTimeStep(uint8_t) {
+    tft.setTextColor(ST77XX_DARKGREY, ST77XX_WHITE);
+    tft.setCursor(10, 222);
+    tft.print(F("Boot: "));
+    tft.print(timeToFirstControlUs / 1000);
+    tft.print(F(" ms"));
+    boot_time_drawn = true;
+    return true;
+}
+
+// --- Active motion profile ---
+uint8_t profile_generation_drawn = 0;
+bool profile_drawn = false;
+
+bool profileDirty(uint8_t) {
+    return !profile_drawn || profile_generation_drawn != configGeneration;
+}
+
+bool profileStep(uint8_t) {
+    const char* name = configProfileName();
+    tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+    tft.setCursor(150, 29);
+    tft.print(F("Profile: "));
+    tft.print(name);
+    for (size_t i = strlen(name); i < PROFILE_NAME_LEN - 1; ++i) tft.print(' '); // Clear a longer previous name
+    profile_generation_drawn = configGeneration;
+    profile_drawn = true;
+    return true;
+}
+
+// --- Stack high-water mark ---
+// The paint scan walks the whole free gap, so it is sampled at most once a second
+const unsigned long STACK_SAMPLE_MS = 1000;
+uint16_t stack_peak_sampled = 0;
+uint16_t stack_peak_drawn = 0xFFFF;
+unsigned long stackSampleMs = 0;
+
+bool stackPeakDirty(uint8_t) {
+    if (millis() - stackSampleMs >= STACK_SAMPLE_MS) {
+        stackSampleMs = millis();
+        stack_peak_sampled = memwatchStackPeak();
+    }
+    return stack_peak_sampled != stack_peak_drawn;
+}
+
+bool stackPeakStep(uint8_t) {
+    tft.setTextColor(ST77XX_DARKGREY, ST77XX_WHITE);
+    tft.setCursor(10, 232);
+    tft.print(F("Stack: "));
+    tft.print(stack_peak_sampled);
+    tft.print(F(" B  ")); // Trailing spaces clear a longer previous value
+    stack_peak_drawn = stack_peak_sampled;
+    return true;
+}
+
+// --- Loop supervisor ---
+// Overrun counts change in bursts, so like the stack peak they are sampled once a second
+const unsigned long LOOP_STATS_SAMPLE_MS = 1000;
+unsigned long late_ticks_sampled = 0, overruns_sampled = 0;
+unsigned long late_ticks_drawn = 0xFFFFFFFF, overruns_drawn = 0xFFFFFFFF;
+unsigned long loopStatsSampleMs = 0;
+
+bool loopStatsDirty(uint8_t) {
+    if (millis() - loopStatsSampleMs >= LOOP_STATS_SAMPLE_MS) {
+        loopStatsSampleMs = millis();
+        late_ticks_sampled = supervisorStats.lateTicks;
+        overruns_sampled = supervisorOverruns();
+    }
+    return late_ticks_sampled != late_ticks_drawn || overruns_sampled != overruns_drawn;
+}
+
+bool loopStatsStep(uint8_t) {
+    tft.setTextColor(ST77XX_DARKGREY, ST77XX_WHITE);
+    tft.setCursor(10, 100);
+    tft.print(F("Late: "));
+    tft.print(late_ticks_sampled);
+    tft.print(F(" Ovr: "));
+    tft.print(overruns_sampled);
+    tft.print(F("  "));
+    late_ticks_drawn = late_ticks_sampled;
+    overruns_drawn = overruns_sampled;
+    return true;
+}
+
+bool safe_state_drawn = false;
+bool safe_state_shown = false;
+uint16_t fault_count_drawn = 0xFFFF;
+
+uint16_t faultCountTotal() {
+    return faultLog.counts[FAULT_WATCHDOG] + faultLog.counts[FAULT_OVERRUN];
+}
+
+bool safeStateDirty(uint8_t) {
+    return !safe_state_drawn || supervisorSafeState() != safe_state_shown || faultCountTotal() != fault_count_drawn;
+}
+
+bool safeStateStep(uint8_t) {
+    safe_state_shown = supervisorSafeState();
+    tft.setCursor(10, 112);
+    if (safe_state_shown) {
+        tft.setTextColor(ST77XX_WHITE, ST77XX_RED);
+        tft.print(F("SAFE STATE: CENTER"));
+    } else {
+        tft.setTextColor(ST77XX_DARKGREY, ST77XX_WHITE);
+        tft.print(F("Faults: W"));
+        tft.print(faultLog.counts[FAULT_WATCHDOG]);
+        tft.print(F(" O"));
+        tft.print(faultLog.counts[FAULT_OVERRUN]);
+        tft.print(F("      ")); // Clears the longer safe-state banner
+    }
+    fault_count_drawn = faultCountTotal();
+    safe_state_drawn = true;
+    return true;
+}
+
+// --- Running macro ---
+uint8_t macro_generation_drawn = 0;
+bool macro_drawn = false;
+
+bool macroDirty(uint8_t) {
+    return !macro_drawn || macro_generation_drawn != macroGeneration;
+}
+
+bool macroStep(uint8_t) {
+    tft.setTextColor(ST77XX_BLACK, ST77XX_WHITE);
+    tft.setCursor(150, 141);
+    size_t shown = 0;
+    if (macroRunning()) {
+        tft.print(F("Macro: "));
+        tft.print(macroName());
+        shown = 7 + flashStrlen(macroName());
+    }
+    for (; shown < 7 + MACRO_NAME_LEN - 1; ++shown) tft.print(' '); // Clear the previous name
+    macro_generation_drawn = macroGeneration;
+    macro_drawn = true;
+    return true;
+}
+
+// Seed costs are rough worst-case step timings over software SPI; the scheduler refines them
+// Task names are only printed by the bench, so they stay in flash
+const char RENDER_NAME_JOY_X[] PROGMEM = "joy_x";
+const char RENDER_NAME_JOY_Y[] PROGMEM = "joy_y";
+const char RENDER_NAME_JOY_BOX[] PROGMEM = "joy_box";
+const char RENDER_NAME_JOY_DOT[] PROGMEM = "joy_dot";
+const char RENDER_NAME_BUTTON_0[] PROGMEM = "button_0";
+const char RENDER_NAME_BUTTON_1[] PROGMEM = "button_1";
+const char RENDER_NAME_BUTTON_2[] PROGMEM = "button_2";
+const char RENDER_NAME_BUTTON_3[] PROGMEM = "button_3";
+const char RENDER_NAME_MAGNET[] PROGMEM = "magnet";
+const char RENDER_NAME_GAUGE_0[] PROGMEM = "gauge_0";
+const char RENDER_NAME_GAUGE_1[] PROGMEM = "gauge_1";
+const char RENDER_NAME_GAUGE_2[] PROGMEM = "gauge_2";
+const char RENDER_NAME_SERVO_READOUT_0[] PROGMEM = "servo_readout_0";
+const char RENDER_NAME_SERVO_READOUT_1[] PROGMEM = "servo_readout_1";
+const char RENDER_NAME_SERVO_READOUT_2[] PROGMEM = "servo_readout_2";
+const char RENDER_NAME_BOOT_TIME[] PROGMEM = "boot_time";
+const char RENDER_NAME_STACK_PEAK[] PROGMEM = "stack_peak";
+const char RENDER_NAME_PROFILE[] PROGMEM = "profile";
+const char RENDER_NAME_LOOP_STATS[] PROGMEM = "loop_stats";
+const char RENDER_NAME_SAFE_STATE[] PROGMEM = "safe_state";
+const char RENDER_NAME_MACRO[] PROGMEM = "macro";
+
+RenderTask renderTasks[] = {
+    { asFlash(RENDER_NAME_JOY_X),           joyTextDirty, joyTextStep, 0,  700, 0, false },
+    { asFlash(RENDER_NAME_JOY_Y),           joyTextDirty, joyTextStep, 1,  700, 0, false },
+    { asFlash(RENDER_NAME_JOY_BOX),         joyBoxDirty,  joyBoxStep,  0,  600, 0, false },
+    { asFlash(RENDER_NAME_JOY_DOT),         joyDotDirty,  joyDotStep,  0,  500, 0, false },
+    { asFlash(RENDER_NAME_BUTTON_0),        buttonDirty,  buttonStep,  0,  800, 0, false },
+    { asFlash(RENDER_NAME_BUTTON_1),        buttonDirty,  buttonStep,  1,  800, 0, false },
+    { asFlash(RENDER_NAME_BUTTON_2),        buttonDirty,  buttonStep,  2,  800, 0, false },
+    { asFlash(RENDER_NAME_BUTTON_3),        buttonDirty,  buttonStep,  3,  800, 0, false },
+    { asFlash(RENDER_NAME_MAGNET),          magnetDirty,  magnetStep,  0,  800, 0, false },
+    { asFlash(RENDER_NAME_GAUGE_0),         gaugeDirty,   gaugeStep,   0, 1000, 0, false },
+    { asFlash(RENDER_NAME_GAUGE_1),         gaugeDirty,   gaugeStep,   1, 1000, 0, false },
+    { asFlash(RENDER_NAME_GAUGE_2),         gaugeDirty,   gaugeStep,   2, 1000, 0, false },
+    { asFlash(RENDER_NAME_SERVO_READOUT_0), servoReadoutDirty, servoReadoutStep, 0, 1200, 0, false },
+    { asFlash(RENDER_NAME_SERVO_READOUT_1), servoReadoutDirty, servoReadoutStep, 1, 1200, 0, false },
+    { asFlash(RENDER_NAME_SERVO_READOUT_2), servoReadoutDirty, servoReadoutStep, 2, 1200, 0, false },
+    { asFlash(RENDER_NAME_BOOT_TIME),       bootTimeDirty, bootTimeStep, 0, 600, 0, false },
+    { asFlash(RENDER_NAME_STACK_PEAK),      stackPeakDirty, stackPeakStep, 0, 700, 0, false },
+    { asFlash(RENDER_NAME_PROFILE),         profileDirty, profileStep, 0, 1200, 0, false },
+    { asFlash(RENDER_NAME_LOOP_STATS),      loopStatsDirty, loopStatsStep, 0, 900, 0, false },
+    { asFlash(RENDER_NAME_SAFE_STATE),      safeStateDirty, safeStateStep, 0, 1100, 0, false },
+    { asFlash(RENDER_NAME_MACRO),           macroDirty,   macroStep,   0, 1200, 0, false }
+};
+const size_t NUM_RENDER_TASKS = sizeof(renderTasks)/sizeof(RenderTask);
+
+void displayInvalidateAll() {
+    prev_joystickX_display = -1;
+    prev_joystickY_display = -1;
+    joy_box_drawn = false;
+    for (size_t i = 0; i < 2; ++i) readoutInvalidate(joyReadouts[i]);
+    for (size_t i = 0; i < NUM_SERVO_GAUGES; ++i) {
+        readoutInvalidate(servoReadouts[i]);
+        prev_gauge_px[i] = -1;
+    }
+    for (size_t i = 0; i < NUM_BUTTONS; ++i) {
+        buttonWidgets[i].drawn = false;
+        buttonWidgets[i].phase = BUTTON_PHASE_LABEL;
+    }
+    magnetWidget.drawn = false;
+    magnetWidget.filling = false;
+    boot_time_drawn = false;
+    stack_peak_drawn = 0xFFFF;
+    profile_drawn = false;
+    late_ticks_drawn = overruns_drawn = 0xFFFFFFFF;
+    safe_state_drawn = false;
+    macro_drawn = false;
+    for (size_t i = 0; i < NUM_RENDER_TASKS; ++i) renderTasks[i].inProgress = false;
+}
+
+// Budgeted cooperative display update: runs render steps, stalest first, for as long as
+// their estimated cost fits in what is left of the current control tick.
+// After RENDER_STARVE_TICKS ticks without a step, one step runs whatever it costs.
+void updateDisplay_cooperative(unsigned long tickStartUs) {
+    static uint8_t starvedTicks = 0;  // Ticks in a row that ran no render step while one was waiting
+    bool ran = false;
+    bool waiting = true;              // Unknown until the tasks are scanned: assume something is
+    while (true) {
+        unsigned long elapsed = micros() - tickStartUs;
+        bool force = !ran && starvedTicks >= RENDER_STARVE_TICKS;
+        unsigned long remaining = 0;
+        if (elapsed + DISPLAY_BUDGET_MARGIN_US < CONTROL_PERIOD_US) {
+            remaining = CONTROL_PERIOD_US - DISPLAY_BUDGET_MARGIN_US - elapsed;
+        } else if (!force) {
+            break;
+        }
+
+        if (displayBootPhase != BOOT_DONE) {
+            waiting = false; // Bring-up has its own pacing
+            if (remaining < BOOT_STEP_COST_US) break;
+            displayBootStep();
+            if (bootWaiting) break; // Nothing to do this tick
+            continue;
+        }
+
+        unsigned long now = millis();
+        int pick = -1;
+        unsigned long pickAge = 0;
+        waiting = false;
+        for (size_t i = 0; i < NUM_RENDER_TASKS; ++i) {
+            RenderTask &task = renderTasks[i];
+            if (!task.inProgress && !task.dirty(task.arg)) continue;
+            if (task.costUs > remaining && !force) {
+                waiting = true;
+                continue;
+            }
+            unsigned long age = now - task.lastDoneMs;
+            if (pick < 0 || age > pickAge) {
+                pick = i;
+                pickAge = age;
+            }
+        }
+        if (pick < 0) break; // Nothing to draw, or nothing fits in the remaining budget
+
+        RenderTask &task = renderTasks[pick];
+        unsigned long stepStart = micros();
+        traceRecord(TRACE_DISPLAY_BEGIN, pick);
+        bool done = task.step(task.arg);
+        traceRecord(TRACE_DISPLAY_END, pick | (done ? 0x100 : 0));
+        unsigned long measured = micros() - stepStart;
+
+        // Track cost: rise immediately on an overrun, decay slowly otherwise
+        if (measured > task.costUs) {
+            task.costUs = min(measured, (unsigned long)RENDER_STEP_COST_CAP_US);
+        } else {
+            task.costUs = (task.costUs * 7 + measured) / 8;
+        }
+        task.inProgress = !done;
+        if (done) task.lastDoneMs = millis();
+        ran = true;
+    }
+    if (ran || !waiting) {
+        starvedTicks = 0;
+    } else if (starvedTicks < RENDER_STARVE_TICKS) {
+        starvedTicks++;
+    }
+}
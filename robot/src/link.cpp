@@ -0,0 +1,234 @@
+#include <Arduino.h>
+#include "link.h"
+#include "control.h"
+#include "crc16.h"
+
+LinkStats linkStats;
+
+#if LINK_ROLE != LINK_NONE
+
+const uint8_t LINK_HEADER_BYTES = 8;  // addr type seq len ts[4], after the SOF
+const uint8_t LINK_POSE_PAYLOAD = 4 + 2 * ARM_AXES;
+static_assert(LINK_POSE_PAYLOAD <= LINK_MAX_PAYLOAD, "pose frame too long");
+const uint8_t LINK_QUEUE_LEN = LINK_APPLY_DELAY_TICKS + 2;
+const unsigned long LINK_APPLY_DELAY_US = LINK_APPLY_DELAY_TICKS * CONTROL_PERIOD_US;
+
+// Poses waiting for their apply time (local clock), oldest first
+struct PendingPose {
+    unsigned long applyAtUs;
+    uint16_t centideg[ARM_AXES];
+};
+
+static PendingPose queue[LINK_QUEUE_LEN];
+static uint8_t queueCount = 0;
+static unsigned long tickUs = 0;  // Start of the current control tick (local clock)
+
+#if LINK_ROLE == LINK_SLAVE
+// A slave ramps onto the master's pose at the soft-start rate (after boot and
+// after the safe state) and only then follows it pose for pose
+static float followTarget[ARM_AXES];
+static bool haveTarget = false;
+static bool following = false;
+
+void linkRamp() {
+    following = false;
+}
+#else
+void linkRamp() {}
+#endif
+
+static void enqueue(unsigned long applyAtUs, const uint16_t centideg[ARM_AXES]) {
+    if (queueCount == LINK_QUEUE_LEN) {
+        // Full: the oldest pose is superseded by the ones behind it
+        memmove(&queue[0], &queue[1], sizeof(PendingPose) * (LINK_QUEUE_LEN - 1));
+        queueCount--;
+    }
+    PendingPose &p = queue[queueCount++];
+    p.applyAtUs = applyAtUs;
+    memcpy(p.centideg, centideg, sizeof(p.centideg));
+}
+
+// Applied on the control tick nearest to the apply time, so units whose tick
+// grids are aligned pick the same tick
+void linkApplyDue() {
+    tickUs = micros();
+    while (queueCount > 0 && (long)(queue[0].applyAtUs - tickUs) <= (long)(CONTROL_PERIOD_US / 2)) {
+        const PendingPose &p = queue[0];
+        if ((long)(tickUs - p.applyAtUs) > (long)CONTROL_PERIOD_US) linkStats.lateApplies++;
+        float pose[ARM_AXES];
+        for (uint8_t i = 0; i < ARM_AXES; ++i) pose[i] = p.centideg[i] / 100.0f;
+#if LINK_ROLE == LINK_MASTER
+        writeServoOutputs(pose);
+#else
+        memcpy(followTarget, pose, sizeof(followTarget));
+        haveTarget = true;
+        if (following) moveServos(pose);
+#endif
+        memmove(&queue[0], &queue[1], sizeof(PendingPose) * (queueCount - 1));
+        queueCount--;
+    }
+#if LINK_ROLE == LINK_SLAVE
+    if (haveTarget && !following) {
+        float before[ARM_AXES];
+        memcpy(before, currentServoPos, sizeof(before));
+        // Caught up, or held at a limit the target lies beyond
+        following = !slewToward(followTarget, SOFT_START_DEG_PER_TICK) ||
+                    armEqual<ARM_AXES>(before, currentServoPos);
+    }
+#endif
+}
+
+#if LINK_ROLE == LINK_MASTER
+
+static void put32(uint8_t* p, unsigned long v) {
+    for (uint8_t i = 0; i < 4; ++i) p[i] = (uint8_t)(v >> (8 * i));
+}
+
+static uint8_t txSeq = 0;
+static uint16_t lastSent[ARM_AXES] = ARM_AXES_INIT(0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF);
+static unsigned long lastSentMs = 0;
+
+static void sendFrame(uint8_t addr, uint8_t type, const uint8_t* payload, uint8_t len) {
+    uint8_t header[LINK_HEADER_BYTES] = { addr, type, txSeq++, len };
+    // One frame per tick leaves the TX buffer drained, so the SOF starts shifting out right away
+    Serial.write(LINK_SOF);
+    put32(&header[4], micros());
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < LINK_HEADER_BYTES; ++i) crc = crc16Update(crc, header[i]);
+    for (uint8_t i = 0; i < len; ++i) crc = crc16Update(crc, payload[i]);
+    Serial.write(header, LINK_HEADER_BYTES);
+    Serial.write(payload, len);
+    Serial.write((uint8_t)crc);
+    Serial.write((uint8_t)(crc >> 8));
+    linkStats.framesSent++;
+}
+
+void linkPublishPose() {
+    uint16_t centideg[ARM_AXES];
+    for (uint8_t i = 0; i < ARM_AXES; ++i) centideg[i] = (uint16_t)(currentServoPos[i] * 100.0f + 0.5f);
+    bool changed = memcmp(centideg, lastSent, sizeof(centideg)) != 0;
+    if (!changed && millis() - lastSentMs < LINK_HEARTBEAT_MS) return;
+    if (Serial.availableForWrite() < 1 + LINK_HEADER_BYTES + LINK_POSE_PAYLOAD + 2) return; // Retry next tick
+
+    uint8_t payload[LINK_POSE_PAYLOAD];
+    put32(payload, tickUs);
+    for (uint8_t i = 0; i < ARM_AXES; ++i) {
+        payload[4 + 2 * i] = (uint8_t)centideg[i];
+        payload[5 + 2 * i] = (uint8_t)(centideg[i] >> 8);
+    }
+    sendFrame(LINK_BROADCAST, LINK_FRAME_POSE, payload, sizeof(payload));
+    if (changed) enqueue(tickUs + LINK_APPLY_DELAY_US, centideg); // The master's own servos wait too
+    memcpy(lastSent, centideg, sizeof(lastSent));
+    lastSentMs = millis();
+}
+
+void linkPoll() {
+    while (Serial.available()) Serial.read(); // Slaves do not transmit
+}
+
+long linkPhaseCorrectionUs(unsigned long) {
+    return 0;
+}
+
+#else // LINK_SLAVE
+
+static unsigned long get32(const uint8_t* p) {
+    unsigned long v = 0;
+    for (uint8_t i = 0; i < 4; ++i) v |= (unsigned long)p[i] << (8 * i);
+    return v;
+}
+
+static uint8_t rxBuf[LINK_HEADER_BYTES + LINK_MAX_PAYLOAD + 2];
+static uint8_t rxLen = 0;
+static bool rxInFrame = false;
+static unsigned long rxSofUs = 0;      // Local time the SOF finished arriving
+static uint8_t rxLastSeq = 0;
+static bool rxHaveSeq = false;
+
+static long offsetSamples[LINK_SYNC_WINDOW];
+static uint8_t offsetCount = 0, offsetNext = 0;
+static unsigned long masterTickLocalUs = 0;
+static bool phaseFresh = false;
+
+// Receive stamps are only ever late (buffered bytes, slow polls), so the
+// largest master-minus-local sample in the window is the best estimate
+static void addOffsetSample(long sample) {
+    offsetSamples[offsetNext] = sample;
+    offsetNext = (offsetNext + 1) % LINK_SYNC_WINDOW;
+    if (offsetCount < LINK_SYNC_WINDOW) offsetCount++;
+    long best = offsetSamples[0];
+    for (uint8_t i = 1; i < offsetCount; ++i) best = max(best, offsetSamples[i]);
+    linkStats.offsetUs = best;
+    linkStats.synced = true;
+}
+
+static void handleFrame() {
+    uint8_t len = rxBuf[3];
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < LINK_HEADER_BYTES + len; ++i) crc = crc16Update(crc, rxBuf[i]);
+    uint8_t* tail = &rxBuf[LINK_HEADER_BYTES + len];
+    if (crc != (uint16_t)(tail[0] | (tail[1] << 8))) {
+        linkStats.crcErrors++;
+        return;
+    }
+    uint8_t addr = rxBuf[0], type = rxBuf[1], seq = rxBuf[2];
+    linkStats.framesReceived++;
+    if (rxHaveSeq && seq != (uint8_t)(rxLastSeq + 1)) linkStats.seqGaps++;
+    rxLastSeq = seq;
+    rxHaveSeq = true;
+
+    // Every frame from the master syncs the clock, whoever it is addressed to
+    unsigned long masterSofUs = get32(&rxBuf[4]) + LINK_BYTE_US;
+    addOffsetSample((long)(masterSofUs - rxSofUs));
+
+    if (addr != LINK_BROADCAST && addr != LINK_ADDRESS) return;
+    if (type == LINK_FRAME_POSE && len == LINK_POSE_PAYLOAD) {
+        const uint8_t* p = &rxBuf[LINK_HEADER_BYTES];
+        uint16_t centideg[ARM_AXES];
+        for (uint8_t i = 0; i < ARM_AXES; ++i) centideg[i] = p[4 + 2 * i] | (p[5 + 2 * i] << 8);
+        masterTickLocalUs = get32(p) - linkStats.offsetUs;
+        phaseFresh = true;
+        enqueue(masterTickLocalUs + LINK_APPLY_DELAY_US, centideg);
+    }
+}
+
+void linkPoll() {
+    while (Serial.available()) {
+        uint8_t c = Serial.read();
+        if (!rxInFrame) {
+            if (c == LINK_SOF) {
+                rxInFrame = true;
+                rxLen = 0;
+                // Bytes already queued behind the SOF tell how long ago it arrived
+                rxSofUs = micros() - Serial.available() * LINK_BYTE_US;
+            }
+            continue;
+        }
+        rxBuf[rxLen++] = c;
+        if (rxLen == 4 && rxBuf[3] > LINK_MAX_PAYLOAD) {
+            rxInFrame = false; // Not a frame header, resync on the next SOF
+            continue;
+        }
+        if (rxLen >= 4 && rxLen == LINK_HEADER_BYTES + rxBuf[3] + 2) {
+            handleFrame();
+            rxInFrame = false;
+        }
+    }
+}
+
+void linkPublishPose() {}
+
+// Nudge this unit's tick start toward the master's by half the phase error
+long linkPhaseCorrectionUs(unsigned long tickStartUs) {
+    if (!phaseFresh) return 0;
+    phaseFresh = false;
+    const long period = CONTROL_PERIOD_US;
+    long error = (long)(tickStartUs - masterTickLocalUs) % period;
+    if (error >= period / 2) error -= period;
+    if (error < -period / 2) error += period;
+    return -error / 2;
+}
+
+#endif // LINK_SLAVE
+
+#endif // LINK_ROLE != LINK_NONE
@@ -0,0 +1,222 @@
+#include <Arduino.h>
+#include "macro.h"
+#include "control.h"
+#include "link.h"
+#include "flash.h"
+#include "trace.h"
+
+// Station moves for the pick-and-place line. Poses: yaw, shoulder (90 = upper
+// arm vertical), elbow (180 = straight); (x, 90, 90) carries a part level at
+// 170 mm, (x, 45, 60) puts the magnet ~35 mm over the table, (x, 60, 90) over a bin.
+const Macro MACROS_P[] PROGMEM = {
+    { "Pick", TRIGGER_CENTER_DOWN,
+      { { MACRO_MOVE,   5,  { MACRO_KEEP, 45, 60 } },
+        { MACRO_MAGNET, HIGH, { 0, 0, 0 } },
+        { MACRO_WAIT,   20, { 0, 0, 0 } },
+        { MACRO_MOVE,   5,  { MACRO_KEEP, 90, 90 } } }
+    },
+    { "Drop", TRIGGER_CENTER_UP,
+      { { MACRO_MOVE,   5,  { MACRO_KEEP, 45, 60 } },
+        { MACRO_MAGNET, LOW, { 0, 0, 0 } },
+        { MACRO_WAIT,   20, { 0, 0, 0 } },
+        { MACRO_MOVE,   5,  { MACRO_KEEP, 90, 90 } } }
+    },
+    { "Left bin", TRIGGER_FLICK_LEFT,
+      { { MACRO_MOVE,   8,  { MACRO_KEEP, 90, 90 } },
+        { MACRO_MOVE,   10, { 150, MACRO_KEEP, MACRO_KEEP } },
+        { MACRO_MOVE,   5,  { MACRO_KEEP, 60, 90 } },
+        { MACRO_MAGNET, LOW, { 0, 0, 0 } },
+        { MACRO_WAIT,   30, { 0, 0, 0 } },
+        { MACRO_MOVE,   8,  { MACRO_KEEP, 90, 90 } } }
+    },
+    { "Right bin", TRIGGER_FLICK_RIGHT,
+      { { MACRO_MOVE,   8,  { MACRO_KEEP, 90, 90 } },
+        { MACRO_MOVE,   10, { 30, MACRO_KEEP, MACRO_KEEP } },
+        { MACRO_MOVE,   5,  { MACRO_KEEP, 60, 90 } },
+        { MACRO_MAGNET, LOW, { 0, 0, 0 } },
+        { MACRO_WAIT,   30, { 0, 0, 0 } },
+        { MACRO_MOVE,   8,  { MACRO_KEEP, 90, 90 } } }
+    },
+    { "Home", TRIGGER_FLICK_DOWN,
+      { { MACRO_MOVE,   8,  { MACRO_KEEP, 90, 90 } },
+        { MACRO_MOVE,   10, { 90, 90, 90 } } }
+    }
+};
+const size_t NUM_MACROS = sizeof(MACROS_P) / sizeof(Macro);
+const Flash<Macro> MACROS(MACROS_P);
+
+const float MACRO_SPEED_SCALE = 0.1f; // MACRO_MOVE arg units, deg per tick
+
+uint8_t macroGeneration = 0;
+
+static int8_t running = -1;           // Index into MACROS_P, -1 = idle
+static uint8_t lastRun = 0;
+static uint8_t stepIndex = 0;
+static bool stepStarted = false;
+static unsigned long stepStartMs = 0;
+
+static uint8_t heldMask = 0;          // Buttons held on the previous tick
+static bool chordFired = false;       // Since CENTER went down
+static uint8_t chordLatch = 0;        // Buttons of a fired chord that are still held
+static bool flickTracking = false;    // Joystick out of the deadzone
+static unsigned long flickStartMs = 0;
+static float flickPeak = 0.0f;
+static float flickAngle = 0.0f;
+
+static void startMacro(uint8_t trigger) {
+    for (size_t i = 0; i < NUM_MACROS; ++i) {
+        if (MACROS.field(i, &Macro::trigger) != trigger) continue;
+        running = i;
+        lastRun = i;
+        stepIndex = 0;
+        stepStarted = false;
+        macroGeneration++;
+        if (!LINK_ENABLED) {
+            Serial.print(F("Macro: "));
+            Serial.println(macroName());
+        }
+        return;
+    }
+}
+
+static void finish() {
+    running = -1;
+    macroGeneration++;
+}
+
+void macroCancel() {
+    if (running < 0) return;
+    finish();
+    if (!LINK_ENABLED) Serial.println(F("Macro cancelled"));
+}
+
+bool macroRunning() {
+    return running >= 0;
+}
+
+FlashString macroName() {
+    return asFlash(MACROS.ptr()[lastRun].name);
+}
+
+bool macroChordUsed() {
+    return chordFired;
+}
+
+static uint8_t buttonBit(byte pin) {
+    for (size_t i = 0; i < NUM_BUTTONS; ++i) {
+        if (buttons[i].pin == pin) return 1 << i;
+    }
+    return 0;
+}
+
+bool macroChordLatched(byte pin) {
+    return (chordLatch & buttonBit(pin)) != 0;
+}
+
+// Gestures from this tick's button and joystick state; returns the trigger, if any,
+// and reports whether anything new was input (which cancels a running macro)
+static uint8_t readGestures(bool &input) {
+    uint8_t trigger = TRIGGER_NONE;
+    uint8_t mask = 0;
+    for (size_t i = 0; i < NUM_BUTTONS; ++i) {
+        if (buttons[i].stableState == LOW) mask |= 1 << i;
+    }
+    bool centerHeld = buttonHeld(CENTER_JOY_PIN);
+    bool chordOpen = centerChordOpen();
+    chordLatch &= mask; // A chord button stays latched until it is released itself
+    bool upSteps = !chordOpen && buttonHeld(UP_PIN) && !macroChordLatched(UP_PIN);
+    bool downSteps = !chordOpen && buttonHeld(DOWN_PIN) && !macroChordLatched(DOWN_PIN);
+    // New presses, or UP/DOWN stepping the arm; chord buttons still held do not count
+    input = (mask & ~heldMask) != 0 || upSteps || downSteps;
+    heldMask = mask;
+
+    if (centerHeld) {
+        if (!chordFired && chordOpen && buttonHeld(UP_PIN)) trigger = TRIGGER_CENTER_UP;
+        if (!chordFired && chordOpen && buttonHeld(DOWN_PIN)) trigger = TRIGGER_CENTER_DOWN;
+        if (trigger != TRIGGER_NONE) {
+            chordFired = true;
+            chordLatch = buttonBit(CENTER_JOY_PIN) | buttonBit(trigger == TRIGGER_CENTER_UP ? UP_PIN : DOWN_PIN);
+        }
+    } else {
+        chordFired = false;
+    }
+
+    float angle, strength;
+    if (joystickPolar(joystickX, joystickY, angle, strength)) {
+        input = true;
+        if (!flickTracking) {
+            flickTracking = true;
+            flickStartMs = millis();
+            flickPeak = 0.0f;
+        }
+        if (strength > flickPeak) {
+            flickPeak = strength;
+            flickAngle = angle;
+        }
+    } else if (flickTracking) {
+        flickTracking = false;
+        if (millis() - flickStartMs <= FLICK_MAX_MS && flickPeak >= FLICK_MIN_STRENGTH) {
+            // Quadrants centered on the up/right/down/left entries of the direction table
+            static const uint8_t FLICKS[4] = { TRIGGER_FLICK_UP, TRIGGER_FLICK_RIGHT, TRIGGER_FLICK_DOWN, TRIGGER_FLICK_LEFT };
+            trigger = FLICKS[(uint8_t)((flickAngle + 45.0f) / 90.0f) & 3];
+        }
+    }
+    return trigger;
+}
+
+// One tick of a coordinated move; returns true once the pose is reached
+static bool moveStep(const MacroStep &step) {
+    float current[ARM_AXES];
+    memcpy(current, currentServoPos, sizeof(current));
+    float delta[ARM_STEERED_AXES];
+    float span = 0.0f;
+    for (uint8_t i = 0; i < ARM_STEERED_AXES; ++i) {
+        delta[i] = step.pose[i] == MACRO_KEEP ? 0.0f : step.pose[i] - current[i];
+        span = max(span, fabs(delta[i]));
+    }
+    if (span == 0.0f) return true;
+    float scale = min(1.0f, step.arg * MACRO_SPEED_SCALE / span);
+    float pose[ARM_AXES];
+    memcpy(pose, current, sizeof(pose));
+    for (uint8_t i = 0; i < ARM_STEERED_AXES; ++i) pose[i] += delta[i] * scale;
+    moveServos(pose);
+    if (armEqual<ARM_AXES>(currentServoPos, current)) {
+        // Limits or the workspace guard hold the arm: the rest of the macro cannot follow
+        finish();
+        if (!LINK_ENABLED) Serial.println(F("Macro blocked"));
+    }
+    return false;
+}
+
+void macroTick() {
+    bool input;
+    uint8_t trigger = readGestures(input);
+    if (input) macroCancel();
+    if (trigger != TRIGGER_NONE) startMacro(trigger);
+    if (running < 0) return;
+
+    MacroStep step = flashRead(&MACROS.ptr()[running].steps[stepIndex]);
+    if (!stepStarted) {
+        stepStarted = true;
+        stepStartMs = millis();
+    }
+    bool done = true;
+    switch (step.op) {
+        case MACRO_END:
+            finish();
+            return;
+        case MACRO_MOVE:
+            done = moveStep(step);
+            break;
+        case MACRO_MAGNET:
+            digitalWrite(MOS_PIN, step.arg);
+            traceRecord(TRACE_MAGNET, step.arg);
+            break;
+        case MACRO_WAIT:
+            done = millis() - stepStartMs >= step.arg * 10UL;
+            break;
+    }
+    if (running < 0 || !done) return;
+    stepStarted = false;
+    if (++stepIndex == MACRO_MAX_STEPS) finish();
+}
@@ -0,0 +1,82 @@
+#include <Arduino.h>
+#include "memwatch.h"
+
+#ifdef __AVR__
+
+extern uint8_t __data_start;
+extern uint8_t _end;        // End of .bss
+extern uint8_t __stack;     // RAMEND
+extern char* __brkval;      // Heap top, 0 while malloc() has never been called
+
+// Runs from .init1, before the C runtime sets up anything (so no C code, and
+// r1 is not zero yet). Fills _end..RAMEND; at this point nothing lives there.
+void memwatchPaint() __attribute__((naked, used, section(".init1")));
+void memwatchPaint() {
+    __asm volatile(
+        "    ldi r30, lo8(_end)    \n"
+        "    ldi r31, hi8(_end)    \n"
+        "    ldi r24, %0           \n"
+        "    ldi r25, hi8(__stack) \n"
+        "    rjmp 2f               \n"
+        "1:  st Z+, r24            \n"
+        "2:  cpi r30, lo8(__stack) \n"
+        "    cpc r31, r25          \n"
+        "    brlo 1b               \n"
+        "    breq 1b               \n"
+        :
+        : "i"(MEMWATCH_PAINT));
+}
+
+static uint8_t* heapEnd() {
+    return __brkval ? (uint8_t*)__brkval : &_end;
+}
+
+uint16_t memwatchStaticBytes() {
+    return &_end - &__data_start;
+}
+
+uint16_t memwatchMinFree() {
+    uint8_t* p = heapEnd();
+    uint8_t* sp = (uint8_t*)SP;
+    uint16_t count = 0;
+    while (p <= sp && *p == MEMWATCH_PAINT) {
+        ++p;
+        ++count;
+    }
+    return count;
+}
+
+uint16_t memwatchStackPeak() {
+    return (&__stack - heapEnd() + 1) - memwatchMinFree();
+}
+
+uint16_t memwatchFreeNow() {
+    return (uint8_t*)SP - heapEnd();
+}
+
+#else
+
+uint16_t memwatchStaticBytes() { return 0; }
+uint16_t memwatchMinFree() { return 0; }
+uint16_t memwatchStackPeak() { return 0; }
+uint16_t memwatchFreeNow() { return 0; }
+
+#endif
+
+void memwatchReport(Print &out) {
+    out.print(F("RAM static "));
+    out.print(memwatchStaticBytes());
+    out.print(F(" B, stack peak "));
+    out.print(memwatchStackPeak());
+    out.print(F(" B, min free "));
+    out.print(memwatchMinFree());
+    out.println(F(" B"));
+}
+
+void memwatchUpdate() {
+    static unsigned long lastReportMs = 0;
+    if (millis() - lastReportMs < MEMWATCH_REPORT_MS) return;
+    if (Serial.availableForWrite() < MEMWATCH_LINE_MAX) return; // Next tick, rather than block on a full TX buffer
+    lastReportMs = millis();
+    memwatchReport(Serial);
+}
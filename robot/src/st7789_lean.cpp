@@ -0,0 +1,261 @@
+#include "st7789_lean.h"
+
+// Printable ASCII of the Adafruit GFX classic 5x7 font, so lean text matches
+// the glyphs the library path draws. One byte per column, bit 0 = top row.
+const uint8_t FONT_5X7[][5] PROGMEM = {
+    { 0x00, 0x00, 0x00, 0x00, 0x00 }, { 0x00, 0x00, 0x5F, 0x00, 0x00 }, // space !
+    { 0x00, 0x07, 0x00, 0x07, 0x00 }, { 0x14, 0x7F, 0x14, 0x7F, 0x14 }, // " #
+    { 0x24, 0x2A, 0x7F, 0x2A, 0x12 }, { 0x23, 0x13, 0x08, 0x64, 0x62 }, // $ %
+    { 0x36, 0x49, 0x56, 0x20, 0x50 }, { 0x00, 0x08, 0x07, 0x03, 0x00 }, // & '
+    { 0x00, 0x1C, 0x22, 0x41, 0x00 }, { 0x00, 0x41, 0x22, 0x1C, 0x00 }, // ( )
+    { 0x2A, 0x1C, 0x7F, 0x1C, 0x2A }, { 0x08, 0x08, 0x3E, 0x08, 0x08 }, // * +
+    { 0x00, 0x80, 0x70, 0x30, 0x00 }, { 0x08, 0x08, 0x08, 0x08, 0x08 }, // , -
+    { 0x00, 0x00, 0x60, 0x60, 0x00 }, { 0x20, 0x10, 0x08, 0x04, 0x02 }, // . /
+    { 0x3E, 0x51, 0x49, 0x45, 0x3E }, { 0x00, 0x42, 0x7F, 0x40, 0x00 }, // 0 1
+    { 0x72, 0x49, 0x49, 0x49, 0x46 }, { 0x21, 0x41, 0x49, 0x4D, 0x33 }, // 2 3
+    { 0x18, 0x14, 0x12, 0x7F, 0x10 }, { 0x27, 0x45, 0x45, 0x45, 0x39 }, // 4 5
+    { 0x3C, 0x4A, 0x49, 0x49, 0x31 }, { 0x41, 0x21, 0x11, 0x09, 0x07 }, // 6 7
+    { 0x36, 0x49, 0x49, 0x49, 0x36 }, { 0x46, 0x49, 0x49, 0x29, 0x1E }, // 8 9
+    { 0x00, 0x00, 0x14, 0x00, 0x00 }, { 0x00, 0x40, 0x34, 0x00, 0x00 }, // : ;
+    { 0x00, 0x08, 0x14, 0x22, 0x41 }, { 0x14, 0x14, 0x14, 0x14, 0x14 }, // < =
+    { 0x00, 0x41, 0x22, 0x14, 0x08 }, { 0x02, 0x01, 0x59, 0x09, 0x06 }, // > ?
+    { 0x3E, 0x41, 0x5D, 0x59, 0x4E }, { 0x7C, 0x12, 0x11, 0x12, 0x7C }, // @ A
+    { 0x7F, 0x49, 0x49, 0x49, 0x36 }, { 0x3E, 0x41, 0x41, 0x41, 0x22 }, // B C
+    { 0x7F, 0x41, 0x41, 0x41, 0x3E }, { 0x7F, 0x49, 0x49, 0x49, 0x41 }, // D E
+    { 0x7F, 0x09, 0x09, 0x09, 0x01 }, { 0x3E, 0x41, 0x41, 0x51, 0x73 }, // F G
+    { 0x7F, 0x08, 0x08, 0x08, 0x7F }, { 0x00, 0x41, 0x7F, 0x41, 0x00 }, // H I
+    { 0x20, 0x40, 0x41, 0x3F, 0x01 }, { 0x7F, 0x08, 0x14, 0x22, 0x41 }, // J K
+    { 0x7F, 0x40, 0x40, 0x40, 0x40 }, { 0x7F, 0x02, 0x1C, 0x02, 0x7F }, // L M
+    { 0x7F, 0x04, 0x08, 0x10, 0x7F }, { 0x3E, 0x41, 0x41, 0x41, 0x3E }, // N O
+    { 0x7F, 0x09, 0x09, 0x09, 0x06 }, { 0x3E, 0x41, 0x51, 0x21, 0x5E }, // P Q
+    { 0x7F, 0x09, 0x19, 0x29, 0x46 }, { 0x26, 0x49, 0x49, 0x49, 0x32 }, // R S
+    { 0x03, 0x01, 0x7F, 0x01, 0x03 }, { 0x3F, 0x40, 0x40, 0x40, 0x3F }, // T U
+    { 0x1F, 0x20, 0x40, 0x20, 0x1F }, { 0x3F, 0x40, 0x38, 0x40, 0x3F }, // V W
+    { 0x63, 0x14, 0x08, 0x14, 0x63 }, { 0x03, 0x04, 0x78, 0x04, 0x03 }, // X Y
+    { 0x61, 0x59, 0x49, 0x4D, 0x43 }, { 0x00, 0x7F, 0x41, 0x41, 0x41 }, // Z [
+    { 0x02, 0x04, 0x08, 0x10, 0x20 }, { 0x00, 0x41, 0x41, 0x41, 0x7F }, // \ ]
+    { 0x04, 0x02, 0x01, 0x02, 0x04 }, { 0x40, 0x40, 0x40, 0x40, 0x40 }, // ^ _
+    { 0x00, 0x03, 0x07, 0x08, 0x00 }, { 0x20, 0x54, 0x54, 0x78, 0x40 }, // ` a
+    { 0x7F, 0x28, 0x44, 0x44, 0x38 }, { 0x38, 0x44, 0x44, 0x44, 0x28 }, // b c
+    { 0x38, 0x44, 0x44, 0x28, 0x7F }, { 0x38, 0x54, 0x54, 0x54, 0x18 }, // d e
+    { 0x00, 0x08, 0x7E, 0x09, 0x02 }, { 0x18, 0xA4, 0xA4, 0x9C, 0x78 }, // f g
+    { 0x7F, 0x08, 0x04, 0x04, 0x78 }, { 0x00, 0x44, 0x7D, 0x40, 0x00 }, // h i
+    { 0x20, 0x40, 0x40, 0x3D, 0x00 }, { 0x7F, 0x10, 0x28, 0x44, 0x00 }, // j k
+    { 0x00, 0x41, 0x7F, 0x40, 0x00 }, { 0x7C, 0x04, 0x78, 0x04, 0x78 }, // l m
+    { 0x7C, 0x08, 0x04, 0x04, 0x78 }, { 0x38, 0x44, 0x44, 0x44, 0x38 }, // n o
+    { 0xFC, 0x18, 0x24, 0x24, 0x18 }, { 0x18, 0x24, 0x24, 0x18, 0xFC }, // p q
+    { 0x7C, 0x08, 0x04, 0x04, 0x08 }, { 0x48, 0x54, 0x54, 0x54, 0x24 }, // r s
+    { 0x04, 0x04, 0x3F, 0x44, 0x24 }, { 0x3C, 0x40, 0x40, 0x20, 0x7C }, // t u
+    { 0x1C, 0x20, 0x40, 0x20, 0x1C }, { 0x3C, 0x40, 0x30, 0x40, 0x3C }, // v w
+    { 0x44, 0x28, 0x10, 0x28, 0x44 }, { 0x4C, 0x90, 0x90, 0x90, 0x7C }, // x y
+    { 0x44, 0x64, 0x54, 0x4C, 0x44 }, { 0x00, 0x08, 0x36, 0x41, 0x00 }, // z {
+    { 0x00, 0x00, 0x77, 0x00, 0x00 }, { 0x00, 0x41, 0x36, 0x08, 0x00 }, // | }
+    { 0x02, 0x01, 0x02, 0x04, 0x02 }                                    // ~
+};
+const char FONT_5X7_FIRST = ' ';
+const char FONT_5X7_LAST = '~';
+const uint8_t FONT_CELL_W = 6, FONT_CELL_H = 8; // Glyph plus spacing column and descender row
+
+#ifdef __AVR__
+
+static inline void csLow()  { PORTD &= ~_BV(LEAN_CS_PIN); }
+static inline void csHigh() { PORTD |= _BV(LEAN_CS_PIN); }
+
+// SCLK idles low (SPI mode 0, as init() leaves it); the panel samples on the rising edge
+#define LEAN_CLOCK() do { PIND = _BV(LEAN_SCLK_PIN); PIND = _BV(LEAN_SCLK_PIN); } while (0)
+#define LEAN_BIT(b, mask) do { \
+        if ((b) & (mask)) PORTD |= _BV(LEAN_MOSI_PIN); else PORTD &= ~_BV(LEAN_MOSI_PIN); \
+        LEAN_CLOCK(); \
+    } while (0)
+
+static inline void sendByte(uint8_t b) {
+    LEAN_BIT(b, 0x80); LEAN_BIT(b, 0x40); LEAN_BIT(b, 0x20); LEAN_BIT(b, 0x10);
+    LEAN_BIT(b, 0x08); LEAN_BIT(b, 0x04); LEAN_BIT(b, 0x02); LEAN_BIT(b, 0x01);
+}
+
+static void sendColor(uint16_t color, uint32_t count) {
+    uint8_t hi = color >> 8, lo = color;
+    if (hi == lo && (hi == 0x00 || hi == 0xFF)) {
+        // Every bit is the same: set MOSI once, then 16 clocks per pixel
+        if (hi) PORTD |= _BV(LEAN_MOSI_PIN); else PORTD &= ~_BV(LEAN_MOSI_PIN);
+        while (count--) {
+            LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK();
+            LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK();
+            LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK();
+            LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK(); LEAN_CLOCK();
+        }
+        return;
+    }
+    while (count--) {
+        sendByte(hi);
+        sendByte(lo);
+    }
+}
+
+static void sendCommand(uint8_t cmd) {
+    PORTD &= ~_BV(LEAN_DC_PIN);
+    sendByte(cmd);
+    PORTD |= _BV(LEAN_DC_PIN);
+}
+
+static inline void noteCall() {}
+
+#else
+
+// Host: nothing is clocked out; pixels, windows and calls are counted like the mock
+static inline void csLow() {}
+static inline void csHigh() {}
+static inline void sendByte(uint8_t) {}
+static void sendColor(uint16_t, uint32_t count) { hostTftStats.pixels += count; }
+static void sendCommand(uint8_t) {}
+static inline void noteCall() { hostTftStats.calls++; }
+
+#endif
+
+static void sendWord(uint16_t w) {
+    sendByte(w >> 8);
+    sendByte(w);
+}
+
+// Column/row range and RAMWR; CS must already be low
+static void sendWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    sendCommand(ST77XX_CASET);
+    sendWord(x);
+    sendWord(x + w - 1);
+    sendCommand(ST77XX_RASET);
+    sendWord(y);
+    sendWord(y + h - 1);
+    sendCommand(ST77XX_RAMWR);
+#ifndef __AVR__
+    hostTftStats.windows++;
+#endif
+}
+
+// Pixels of one color collected until the color changes, across scanlines
+struct ColorRun {
+    const uint16_t* palette;  // 0 = background, 1 = text
+    uint8_t bit;
+    uint16_t count;
+
+    void add(uint8_t b, uint8_t n) {
+        if (b != bit) {
+            flush();
+            bit = b;
+        }
+        count += n;
+    }
+    void flush() {
+        if (count) sendColor(palette[bit], count);
+        count = 0;
+    }
+};
+
+// Trim to the screen like Adafruit_GFX does; false if nothing is left
+bool LeanST7789::clip(int16_t &x, int16_t &y, int16_t &w, int16_t &h) const {
+    if (w < 0) { x += w + 1; w = -w; }
+    if (h < 0) { y += h + 1; h = -h; }
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > _width) w = _width - x;
+    if (y + h > _height) h = _height - y;
+    return w > 0 && h > 0;
+}
+
+void LeanST7789::fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    noteCall();
+    if (!clip(x, y, w, h)) return;
+    csLow();
+    sendWindow(x + _xstart, y + _ystart, w, h);
+    sendColor(color, (uint32_t)w * h);
+    csHigh();
+}
+
+void LeanST7789::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    fillRect(x, y, 1, 1, color);
+}
+
+void LeanST7789::drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    fillRect(x, y, w, 1, color);
+}
+
+void LeanST7789::drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    fillRect(x, y, 1, h, color);
+}
+
+void LeanST7789::startWrite() {
+    csLow();
+}
+
+void LeanST7789::endWrite() {
+    csHigh();
+}
+
+void LeanST7789::setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) {
+    sendWindow(x + _xstart, y + _ystart, w, h);
+}
+
+void LeanST7789::writeColor(uint16_t color, uint32_t len) {
+    sendColor(color, len);
+}
+
+size_t LeanST7789::write(uint8_t c) {
+    return writeText((const char*)&c, 1, false);
+}
+
+size_t LeanST7789::write(const uint8_t* buffer, size_t size) {
+    return writeText((const char*)buffer, size, false);
+}
+
+size_t LeanST7789::print(FlashString s) {
+    return writeText(flashPtr(s), flashStrlen(s), true);
+}
+
+size_t LeanST7789::writeText(const char* text, size_t len, bool inFlash) {
+    if (len == 0) return 0;
+    uint8_t sx = textsize_x, sy = textsize_y;
+    int16_t w = len * FONT_CELL_W * sx, h = FONT_CELL_H * sy;
+    bool lean = textcolor != textbgcolor && len <= LEAN_TEXT_CHARS && cursor_x >= 0 && cursor_y >= 0 &&
+                cursor_x + w <= _width && cursor_y + h <= _height;
+    for (size_t i = 0; lean && i < len; ++i) {
+        char c = inFlash ? pgm_read_byte(&text[i]) : text[i];
+        lean = c >= FONT_5X7_FIRST && c <= FONT_5X7_LAST;
+    }
+    if (!lean) {
+        for (size_t i = 0; i < len; ++i) Adafruit_ST7789::write((uint8_t)(inFlash ? pgm_read_byte(&text[i]) : text[i]));
+        return len;
+    }
+
+    noteCall();
+    const uint16_t palette[2] = { textbgcolor, textcolor };
+    ColorRun run = { palette, 0, 0 };
+    csLow();
+    sendWindow(cursor_x + _xstart, cursor_y + _ystart, w, h);
+    // Each glyph row is read from flash once per scanline row, as a 5-bit column mask
+    uint8_t rowBits[LEAN_TEXT_CHARS];
+    for (uint8_t row = 0; row < FONT_CELL_H; ++row) {
+        uint8_t rowMask = 1 << row;
+        for (size_t i = 0; i < len; ++i) {
+            char c = inFlash ? pgm_read_byte(&text[i]) : text[i];
+            const uint8_t* glyph = FONT_5X7[c - FONT_5X7_FIRST];
+            uint8_t bits = 0;
+            for (uint8_t col = 0; col < 5; ++col) {
+                if (pgm_read_byte(&glyph[col]) & rowMask) bits |= 1 << col;
+            }
+            rowBits[i] = bits;
+        }
+        for (uint8_t ry = 0; ry < sy; ++ry) {
+            for (size_t i = 0; i < len; ++i) {
+                uint8_t bits = rowBits[i];
+                if (bits == 0) {
+                    run.add(0, FONT_CELL_W * sx); // Blank glyph row: one background span
+                    continue;
+                }
+                for (uint8_t col = 0; col < FONT_CELL_W; ++col, bits >>= 1) run.add(bits & 1, sx);
+            }
+        }
+    }
+    run.flush();
+    csHigh();
+    cursor_x += w;
+    return len;
+}
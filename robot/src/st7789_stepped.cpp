@@ -0,0 +1,52 @@
+#include "st7789_stepped.h"
+
+// Adafruit's generic_st7789 list for a 240x320 panel, each entry: command,
+// argument count, arguments, delay in ms before the next command
+const uint8_t ST7789_INIT_P[] PROGMEM = {
+    ST77XX_SWRESET, 0, 150,
+    ST77XX_SLPOUT,  0, 10,
+    ST77XX_COLMOD,  1, 0x55, 10,                                            // 16-bit color
+    ST77XX_MADCTL,  1, 0x08, 0,
+    ST77XX_CASET,   4, 0, 0, 0, ST7789_PANEL_WIDTH, 0,
+    ST77XX_RASET,   4, 0, 0, ST7789_PANEL_HEIGHT >> 8, ST7789_PANEL_HEIGHT & 0xFF, 0,
+    ST77XX_INVON,   0, 10,
+    ST77XX_NORON,   0, 10,
+    ST77XX_DISPON,  0, 10
+};
+
+void SteppedST7789::initBegin() {
+    begin(); // Software SPI pins; the reset line is driven by the caller
+    initOffset = 0;
+    initDelayMs = 0;
+}
+
+bool SteppedST7789::initDue() const {
+    return millis() - initSentMs >= initDelayMs;
+}
+
+bool SteppedST7789::initStep() {
+    if (initOffset >= sizeof(ST7789_INIT_P)) return true;
+    if (!initDue()) return false;
+    const uint8_t* entry = ST7789_INIT_P + initOffset;
+    uint8_t args = pgm_read_byte(entry + 1);
+    sendCommand(pgm_read_byte(entry), entry + 2, args); // The const overload reads the arguments from flash
+    initDelayMs = pgm_read_byte(entry + 2 + args);
+    initSentMs = millis();
+    initOffset += 3 + args;
+    return false;
+}
+
+void SteppedST7789::setRotation(uint8_t r) {
+    static const uint8_t MADCTL[4] = {
+        ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_MY | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_RGB,
+        ST77XX_MADCTL_MX | ST77XX_MADCTL_MV | ST77XX_MADCTL_RGB
+    };
+    rotation = r & 3;
+    _xstart = _ystart = 0;
+    _width = (rotation & 1) ? ST7789_PANEL_HEIGHT : ST7789_PANEL_WIDTH;
+    _height = (rotation & 1) ? ST7789_PANEL_WIDTH : ST7789_PANEL_HEIGHT;
+    uint8_t madctl = MADCTL[rotation];
+    sendCommand(ST77XX_MADCTL, &madctl, 1); // RAM overload
+}
@@ -0,0 +1,326 @@
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <stddef.h>
+#include "supervisor.h"
+#include "control.h"
+#include "config.h"
+#include "link.h"
+#include "flash.h"
+#include "trace.h"
+
+#ifdef __AVR__
+#include <avr/wdt.h>
+#endif
+
+SupervisorStats supervisorStats;
+FaultLog faultLog;
+
+// Longest a stage may run before it counts as an overrun; 0 = not checked
+const unsigned long STAGE_DEADLINE_US_P[NUM_STAGES] PROGMEM = {
+    0,                  // idle
+    1000,               // link
+    2500,               // control
+    2000,               // report
+    CONTROL_PERIOD_US,  // display_boot: one init command or strip per step, also within the tick
+    CONTROL_PERIOD_US   // display: the scheduler itself stops short of the next tick
+};
+const Flash<unsigned long> STAGE_DEADLINE_US(STAGE_DEADLINE_US_P);
+
+const char STAGE_NAME_IDLE[] PROGMEM = "idle";
+const char STAGE_NAME_LINK[] PROGMEM = "link";
+const char STAGE_NAME_CONTROL[] PROGMEM = "control";
+const char STAGE_NAME_REPORT[] PROGMEM = "report";
+const char STAGE_NAME_DISPLAY_BOOT[] PROGMEM = "display_boot";
+const char STAGE_NAME_DISPLAY[] PROGMEM = "display";
+const char* const STAGE_NAMES_P[NUM_STAGES] PROGMEM = {
+    STAGE_NAME_IDLE, STAGE_NAME_LINK, STAGE_NAME_CONTROL,
+    STAGE_NAME_REPORT, STAGE_NAME_DISPLAY_BOOT, STAGE_NAME_DISPLAY
+};
+const Flash<const char*> STAGE_NAMES(STAGE_NAMES_P);
+
+const char FAULT_NAME_NONE[] PROGMEM = "none";
+const char FAULT_NAME_WATCHDOG[] PROGMEM = "watchdog";
+const char FAULT_NAME_OVERRUN[] PROGMEM = "overrun";
+const char* const FAULT_NAMES_P[NUM_FAULT_CAUSES] PROGMEM = { FAULT_NAME_NONE, FAULT_NAME_WATCHDOG, FAULT_NAME_OVERRUN };
+const Flash<const char*> FAULT_NAMES(FAULT_NAMES_P);
+
+// Left behind by the watchdog interrupt for the boot after the reset
+struct WatchdogNote {
+    uint8_t  magic;
+    uint8_t  stage;
+    uint8_t  magnet;    // MOS_PIN level before the interrupt touched it
+    uint8_t  pose[ARM_AXES]; // Commanded angles, rounded
+    uint16_t uptimeS;
+    uint8_t  check;
+};
+const uint8_t WATCHDOG_NOTE_MAGIC = 0xD6;
+
+#ifdef __AVR__
+// .noinit sits below _end, so neither the C runtime nor memwatchPaint() clears it
+static WatchdogNote watchdogNote __attribute__((section(".noinit")));
+#else
+static WatchdogNote watchdogNote;
+#endif
+
+static volatile uint8_t currentStage = STAGE_IDLE;
+static unsigned long stageStartUs = 0;
+static unsigned long lastTickStartUs = 0;
+static bool haveTick = false;
+static bool safeState = false;
+static bool parked = false;
+static bool centerReleased = false;  // CENTER must be seen up before a press acknowledges
+static bool noteValid = false;       // watchdogNote holds a note from before this boot
+static int8_t flushIndex = -1;       // Next byte of faultLog to write; -1 = idle
+static int8_t reportLine = -1;       // Next line of the paced report; -1 = idle
+static unsigned long lastReportMs = 0;
+const uint8_t SUPERVISOR_LINE_MAX = 56; // Longest report line, CR LF included
+
+static uint8_t noteCheck(const WatchdogNote &note) {
+    const uint8_t* p = (const uint8_t*)&note;
+    uint8_t sum = 0xA5;
+    for (uint8_t i = 0; i < offsetof(WatchdogNote, check); ++i) sum ^= p[i];
+    return sum;
+}
+
+#ifdef __AVR__
+
+// A watchdog reset leaves the watchdog running at its shortest period; turn it
+// off before the C runtime starts (the Uno bootloader normally does this too)
+void supervisorWatchdogOff() __attribute__((naked, used, section(".init3")));
+void supervisorWatchdogOff() {
+    MCUSR = 0;
+    wdt_disable();
+}
+
+// First timeout: the loop has not fed the watchdog for WDTO_500MS. WDIE is
+// cleared by the hardware on entry, so the next timeout resets the MCU. A stall
+// with interrupts disabled never gets here and is not noted.
+ISR(WDT_vect) {
+    watchdogNote.stage = currentStage;
+    watchdogNote.magnet = digitalRead(MOS_PIN);
+    for (uint8_t i = 0; i < ARM_AXES; ++i) watchdogNote.pose[i] = (uint8_t)(currentServoPos[i] + 0.5f);
+    watchdogNote.uptimeS = millis() / 1000;
+    watchdogNote.magic = WATCHDOG_NOTE_MAGIC;
+    watchdogNote.check = noteCheck(watchdogNote);
+    if (!SAFE_STATE_MAGNET_HOLD) digitalWrite(MOS_PIN, LOW);
+}
+
+#endif
+
+static void logFault(uint8_t cause, uint8_t stage, uint16_t uptimeS) {
+    FaultRecord &r = faultLog.records[faultLog.next];
+    r.cause = cause;
+    r.stage = stage;
+    r.uptimeS = uptimeS;
+    faultLog.next = (faultLog.next + 1) % FAULT_LOG_SLOTS;
+    if (faultLog.counts[cause] != 0xFFFF) faultLog.counts[cause]++;
+    faultLog.magic = FAULT_LOG_MAGIC;
+    flushIndex = 0; // Rewrite the whole image; unchanged bytes cost no EEPROM write
+}
+
+static void enterSafeState() {
+    if (!SAFE_STATE_MAGNET_HOLD) {
+        digitalWrite(MOS_PIN, LOW);
+        traceRecord(TRACE_MAGNET, LOW);
+    }
+    safeState = true;
+    parked = false;
+    centerReleased = false;
+}
+
+void supervisorSetup() {
+    memset(&supervisorStats, 0, sizeof(supervisorStats));
+    currentStage = STAGE_IDLE;
+    haveTick = false;
+    safeState = false;
+    flushIndex = -1;
+    reportLine = -1;
+    lastReportMs = 0;
+
+    EEPROM.get(FAULT_LOG_EEPROM_ADDR, faultLog);
+    if (faultLog.magic != FAULT_LOG_MAGIC || faultLog.next >= FAULT_LOG_SLOTS) {
+        memset(&faultLog, 0, sizeof(faultLog)); // Written out with the first fault
+    }
+
+    noteValid = watchdogNote.magic == WATCHDOG_NOTE_MAGIC && watchdogNote.check == noteCheck(watchdogNote);
+    watchdogNote.magic = 0; // Consumed: a later reset of another kind must not find it again
+    if (noteValid) logFault(FAULT_WATCHDOG, watchdogNote.stage, watchdogNote.uptimeS);
+    traceSetup(noteValid); // After a watchdog reset the trace shows what led up to it
+}
+
+bool supervisorRestorePose() {
+    if (!noteValid) return false;
+    for (uint8_t i = 0; i < ARM_AXES; ++i) currentServoPos[i] = watchdogNote.pose[i];
+    return true;
+}
+
+void supervisorStart() {
+    if (noteValid) {
+        enterSafeState();
+        if (SAFE_STATE_MAGNET_HOLD && watchdogNote.magnet) digitalWrite(MOS_PIN, HIGH);
+        if (!LINK_ENABLED) {
+            Serial.print(F("Watchdog reset in "));
+            Serial.print(supervisorStageName(watchdogNote.stage));
+            Serial.println(F(", safe state"));
+        }
+    }
+#ifdef __AVR__
+    wdt_enable(WDTO_500MS);
+    WDTCSR |= _BV(WDIE); // Interrupt first, reset on the following timeout
+#endif
+}
+
+void supervisorTickStart(unsigned long tickStartUs) {
+    if (haveTick) {
+        unsigned long gap = tickStartUs - lastTickStartUs;
+        if (gap >= 2 * CONTROL_PERIOD_US) supervisorStats.lateTicks++;
+        if (gap > supervisorStats.maxTickGapUs) supervisorStats.maxTickGapUs = gap;
+    }
+    lastTickStartUs = tickStartUs;
+    haveTick = true;
+#ifdef __AVR__
+    if (!(WDTCSR & _BV(WDIE))) {
+        // The interrupt fired but the loop came back before the reset: the stall
+        // is an overrun, not a reset, so drop the note and re-arm the interrupt
+        watchdogNote.magic = 0;
+        WDTCSR |= _BV(WDIE);
+    }
+    wdt_reset();
+#endif
+}
+
+void supervisorBegin(SupervisorStage stage) {
+    currentStage = stage;
+    stageStartUs = micros();
+}
+
+void supervisorEnd() {
+    unsigned long elapsed = micros() - stageStartUs;
+    uint8_t stage = currentStage;
+    currentStage = STAGE_IDLE;
+    StageStats &s = supervisorStats.stages[stage];
+    if (elapsed > s.maxUs) s.maxUs = elapsed;
+    unsigned long deadline = STAGE_DEADLINE_US[stage];
+    if (deadline == 0 || elapsed <= deadline) return;
+    s.overruns++;
+    // Repeat stalls while parked only show up in the stats
+    if (elapsed > SUPERVISOR_FAULT_US && !safeState) {
+        supervisorFault(FAULT_OVERRUN, stage);
+        if (!LINK_ENABLED) {
+            Serial.print(F("Overrun: "));
+            Serial.print(supervisorStageName(stage));
+            Serial.print(F(" took "));
+            Serial.print(elapsed);
+            Serial.println(F(" us, safe state"));
+        }
+    }
+}
+
+void supervisorFault(FaultCause cause, uint8_t stage) {
+    logFault(cause, stage, millis() / 1000);
+    enterSafeState();
+    traceRecord(TRACE_FAULT, (uint16_t)cause << 8 | stage);
+    traceFreeze(); // Keep the lead-up for a dump
+}
+
+bool supervisorSafeState() {
+    return safeState;
+}
+
+void supervisorSafeStep() {
+    if (!parked) {
+        parked = !slewToward(motion().center, SOFT_START_DEG_PER_TICK);
+        return;
+    }
+    if (!buttonHeld(CENTER_JOY_PIN)) { // Debounced: a contact bounce does not hand control back
+        centerReleased = true;
+    } else if (centerReleased) {
+        safeState = false;
+        if (!LINK_ENABLED) Serial.println(F("Safe state cleared"));
+    }
+}
+
+bool faultLogTick() {
+    if (flushIndex < 0) return false;
+    EEPROM.update(FAULT_LOG_EEPROM_ADDR + flushIndex, ((const uint8_t*)&faultLog)[flushIndex]);
+    if (++flushIndex == (int8_t)sizeof(faultLog)) flushIndex = -1;
+    return true;
+}
+
+FlashString faultCauseName(uint8_t cause) {
+    return asFlash(cause < NUM_FAULT_CAUSES ? FAULT_NAMES[cause] : FAULT_NAME_NONE);
+}
+
+FlashString supervisorStageName(uint8_t stage) {
+    return asFlash(stage < NUM_STAGES ? STAGE_NAMES[stage] : STAGE_NAME_IDLE);
+}
+
+unsigned long supervisorOverruns() {
+    unsigned long total = 0;
+    for (uint8_t i = 0; i < NUM_STAGES; ++i) total += supervisorStats.stages[i].overruns;
+    return total;
+}
+
+// Line 'line' of the report; false past the last line
+static bool printReportLine(Print &out, uint8_t line) {
+    if (line == 0) {
+        out.print(F("Loop: late ticks "));
+        out.print(supervisorStats.lateTicks);
+        out.print(F(", max gap "));
+        out.print(supervisorStats.maxTickGapUs);
+        out.println(F(" us"));
+        return true;
+    }
+    uint8_t stage = STAGE_LINK + line - 1;
+    if (stage < NUM_STAGES) {
+        const StageStats &s = supervisorStats.stages[stage];
+        out.print(F("  "));
+        out.print(supervisorStageName(stage));
+        out.print(F(": overruns "));
+        out.print(s.overruns);
+        out.print(F(", max "));
+        out.print(s.maxUs);
+        out.println(F(" us"));
+        return true;
+    }
+    line -= NUM_STAGES - STAGE_LINK + 1;
+    if (line == 0) {
+        out.print(F("Faults: watchdog "));
+        out.print(faultLog.counts[FAULT_WATCHDOG]);
+        out.print(F(", overrun "));
+        out.println(faultLog.counts[FAULT_OVERRUN]);
+        return true;
+    }
+    const FaultRecord &last = faultLog.records[(faultLog.next + FAULT_LOG_SLOTS - 1) % FAULT_LOG_SLOTS];
+    if (line == 1 && last.cause != FAULT_NONE && last.cause < NUM_FAULT_CAUSES) {
+        out.print(F("Last fault: "));
+        out.print(faultCauseName(last.cause));
+        out.print(F(" in "));
+        out.print(supervisorStageName(last.stage));
+        out.print(F(" at "));
+        out.print(last.uptimeS);
+        out.println(F(" s"));
+        return true;
+    }
+    return false;
+}
+
+void supervisorReport(Print &out) {
+    for (uint8_t line = 0; printReportLine(out, line); ++line) {}
+}
+
+void supervisorUpdate() {
+    if (reportLine < 0) {
+        if (millis() - lastReportMs < SUPERVISOR_REPORT_MS) return;
+        lastReportMs = millis();
+        reportLine = 0;
+    }
+    // One line per tick, and only if it fits the TX buffer: at 9600 baud the
+    // whole report would hold the loop past SUPERVISOR_FAULT_US
+    if (Serial.availableForWrite() < SUPERVISOR_LINE_MAX) return;
+    if (printReportLine(Serial, reportLine)) {
+        reportLine++;
+    } else {
+        reportLine = -1;
+    }
+}
@@ -0,0 +1,137 @@
+#include <Arduino.h>
+#include "trace.h"
+#include "control.h"
+#include "link.h"
+
+#ifdef __AVR__
+// .noinit, like the watchdog note: neither the C runtime nor memwatchPaint() clears it
+TraceState traceState __attribute__((section(".noinit")));
+#else
+TraceState traceState;
+#endif
+
+const uint8_t TRACE_LINE_MAX = 48; // Longest dump line, CR LF included
+
+static FlashString (*displayName)(uint8_t) = NULL;
+static uint8_t displayNameCount = 0;
+static int16_t dumpLine = -1;      // Next line of the paced dump; -1 = idle
+
+static void clearRing() {
+    traceState.magic = TRACE_MAGIC;
+    traceState.head = 0;
+    traceState.count = 0;
+    traceState.frozen = false;
+    traceState.previousBoot = false;
+}
+
+void traceSetup(bool keep) {
+    bool valid = traceState.magic == TRACE_MAGIC && traceState.head < TRACE_RECORDS &&
+                 traceState.count <= TRACE_RECORDS;
+    if (keep && valid && traceState.count > 0 && !LINK_ENABLED) {
+        // Hold the records from before the reset until someone dumps them
+        traceState.frozen = true;
+        traceState.previousBoot = true;
+        return;
+    }
+    clearRing();
+    dumpLine = -1;
+}
+
+void traceFreeze() {
+    if (LINK_ENABLED) return; // No dump command to unfreeze it: keep recording
+    traceState.frozen = true;
+}
+
+void traceJoystick(int rawX, int rawY) {
+    static uint8_t tracedX = 0, tracedY = 0;
+    uint8_t x = rawX >> 2, y = rawY >> 2;
+    if (abs(x - tracedX) < TRACE_JOY_STEP && abs(y - tracedY) < TRACE_JOY_STEP) return;
+    tracedX = x;
+    tracedY = y;
+    traceRecord(TRACE_JOYSTICK, (uint16_t)x << 8 | y);
+}
+
+void traceSetDisplayNames(FlashString (*name)(uint8_t idx), uint8_t count) {
+    displayName = name;
+    displayNameCount = count;
+}
+
+static void printHex(Print &out, uint32_t v, uint8_t digits) {
+    while (digits--) {
+        uint8_t n = (v >> (4 * digits)) & 0xF;
+        out.print((char)(n < 10 ? '0' + n : 'a' + n - 10));
+    }
+}
+
+// Dump format, one line each: header, button and render task names, records
+// oldest first as "T <tag> <ticks> <value>" in hex, end marker.
+// Returns false once past the end marker.
+static bool printDumpLine(Print &out, uint16_t line) {
+    if (line == 0) {
+        out.print(F("# trace begin records="));
+        out.print(traceState.count);
+        out.print(F(" tick_us="));
+        out.print(TRACE_TICK_US);
+        out.print(F(" prev="));
+        out.println(traceState.previousBoot ? 1 : 0);
+        return true;
+    }
+    line--;
+    if (line < NUM_BUTTONS) {
+        out.print(F("# trace name button "));
+        out.print(line);
+        out.print(' ');
+        out.println(buttons[line].name);
+        return true;
+    }
+    line -= NUM_BUTTONS;
+    if (line < displayNameCount) {
+        out.print(F("# trace name display "));
+        out.print(line);
+        out.print(' ');
+        out.println(displayName(line));
+        return true;
+    }
+    line -= displayNameCount;
+    if (line < traceState.count) {
+        const TraceRecord &r = traceState.ring[(traceState.head - traceState.count + line) & (TRACE_RECORDS - 1)];
+        out.print(F("T "));
+        printHex(out, r.tag, 2);
+        out.print(' ');
+        printHex(out, (uint32_t)r.overflows << 8 | r.tcnt, 6);
+        out.print(' ');
+        printHex(out, r.value, 4);
+        out.println();
+        return true;
+    }
+    if (line == traceState.count) {
+        out.println(F("# trace end"));
+        return true;
+    }
+    return false;
+}
+
+void traceDump(Print &out) {
+    traceState.frozen = true;
+    for (uint16_t line = 0; printDumpLine(out, line); ++line) {}
+    clearRing();
+}
+
+void traceTick() {
+    if (LINK_ENABLED) return; // The link owns the UART
+    while (Serial.available()) {
+        char c = Serial.read();
+        if ((c == 't' || c == 'T') && dumpLine < 0) {
+            traceState.frozen = true; // The ring holds still while it is printed
+            dumpLine = 0;
+        }
+    }
+    // One line per tick, and only if it fits the TX buffer: Serial.print() never blocks here
+    if (dumpLine < 0 || Serial.availableForWrite() < TRACE_LINE_MAX) return;
+    if (printDumpLine(Serial, dumpLine)) {
+        dumpLine++;
+    } else {
+        dumpLine = -1;
+        clearRing();
+    }
+}
@@ -0,0 +1,62 @@
+#include <Arduino.h>
+#include "workspace.h"
+#include "workspace_map.h"
+
+unsigned long workspaceSlides = 0;
+
+const float WORKSPACE_CELL_SCALE = 1.0f / WORKSPACE_CELL_DEG;
+
+static uint8_t cellIndex(float angle) {
+    int cell = (int)(angle * WORKSPACE_CELL_SCALE + 0.5f);
+    return constrain(cell, 0, WORKSPACE_CELLS - 1);
+}
+
+static bool cellAllowed(uint8_t c1, uint8_t c2, uint8_t c3) {
+    uint16_t bit = ((uint16_t)c1 * WORKSPACE_CELLS + c2) * WORKSPACE_CELLS + c3;
+    return !(pgm_read_byte(&WORKSPACE_MAP[bit >> 3]) & (1 << (bit & 7)));
+}
+
+bool workspaceAllowed(float s1, float s2, float s3) {
+    return cellAllowed(cellIndex(s1), cellIndex(s2), cellIndex(s3));
+}
+
+// Cells from the pose to the nearest free cell along any one axis (0 = free),
+// searched only up to limit; anything deeper reports limit + 1
+static uint8_t zoneDepth(const float pose[ARM_STEERED_AXES], uint8_t limit) {
+    uint8_t c[ARM_STEERED_AXES] = { cellIndex(pose[0]), cellIndex(pose[1]), cellIndex(pose[2]) };
+    if (cellAllowed(c[0], c[1], c[2])) return 0;
+    for (uint8_t d = 1; d <= limit; ++d) {
+        for (uint8_t axis = 0; axis < ARM_STEERED_AXES; ++axis) {
+            uint8_t home = c[axis];
+            if (home >= d) {
+                c[axis] = home - d;
+                if (cellAllowed(c[0], c[1], c[2])) return d;
+            }
+            if (home + d < WORKSPACE_CELLS) {
+                c[axis] = home + d;
+                if (cellAllowed(c[0], c[1], c[2])) return d;
+            }
+            c[axis] = home;
+        }
+    }
+    return limit + 1;
+}
+
+void workspaceGuard(const float prev[ARM_AXES], float target[ARM_AXES]) {
+    if (workspaceAllowed(target[0], target[1], target[2])) return;
+
+    // From a free pose this keeps every axis move that stays free. From inside
+    // the zone it keeps the moves that do not go deeper, so the arm can back out
+    // (or work along the edge) but not push further in.
+    float pose[ARM_STEERED_AXES] = { prev[0], prev[1], prev[2] };
+    uint8_t depth = zoneDepth(pose, WORKSPACE_CELLS);
+    for (uint8_t axis = 0; axis < ARM_STEERED_AXES; ++axis) {
+        float saved = pose[axis];
+        pose[axis] = target[axis];
+        uint8_t moved = zoneDepth(pose, depth);
+        if (moved > depth) pose[axis] = saved;
+        else depth = moved;
+    }
+    memcpy(target, pose, sizeof(pose)); // Axes past the map keep their target
+    workspaceSlides++;
+}
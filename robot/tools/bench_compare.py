@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+"""Compare a benchmark run against bench/baseline.txt.
+
+The run is the output of the host runner (ns/op) or the serial log of the
+uno_bench env (cycles/op); the unit on each line selects the baseline column.
+
+Usage: python3 tools/bench_compare.py bench/baseline.txt run.txt [--update]
+  --update  write the run's numbers into the matching baseline column
+"""
+
+import sys
+
+COLUMNS = {"ns/op": 1, "cycles/op": 2}
+
+
+def parse_run(path):
+    results = {}
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) >= 4 and parts[0] == "bench" and parts[3] in COLUMNS:
+                results[parts[1]] = (float(parts[2]), parts[3])
+    return results
+
+
+def parse_baseline(path):
+    header, rows = [], {}
+    with open(path) as f:
+        for line in f:
+            if line.startswith("#") or not line.strip():
+                header.append(line.rstrip("\n"))
+                continue
+            parts = line.split()
+            rows[parts[0]] = parts[1:3]
+    return header, rows
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    if len(args) != 2:
+        print(__doc__)
+        return 2
+    baseline_path, run_path = args
+    header, baseline = parse_baseline(baseline_path)
+    run = parse_run(run_path)
+
+    print("%-26s %12s %12s %8s" % ("name", "baseline", "current", "delta"))
+    for name, (value, unit) in run.items():
+        col = COLUMNS[unit] - 1
+        base = baseline.get(name, ["-", "-"])[col]
+        if base == "-":
+            print("%-26s %12s %12.1f %8s  %s" % (name, "-", value, "new", unit))
+            continue
+        delta = (value - float(base)) / float(base) * 100.0 if float(base) else 0.0
+        print("%-26s %12s %12.1f %+7.1f%%  %s" % (name, base, value, delta, unit))
+
+    if "--update" in sys.argv:
+        for name, (value, unit) in run.items():
+            row = baseline.setdefault(name, ["-", "-"])
+            row[COLUMNS[unit] - 1] = "%.1f" % value if unit == "ns/op" else "%d" % value
+        with open(baseline_path, "w") as f:
+            for line in header:
+                f.write(line + "\n")
+            for name, row in baseline.items():
+                f.write("%-26s %10s %10s\n" % (name, row[0], row[1]))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
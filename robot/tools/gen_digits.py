@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Generate include/digit_glyphs.h: run-length-encoded numeric glyphs for the TFT.
+
+Glyphs are seven-segment style digits rasterized from thick line segments,
+so no font files or imaging libraries are needed. Each glyph is a row-major
+bitmap encoded as alternating background/foreground run lengths, starting
+with background. A run longer than 255 is split as 255, 0, rest.
+
+Usage: python3 tools/gen_digits.py > include/digit_glyphs.h
+"""
+
+import math
+
+# Characters available in each font, in table order
+CHARSET = "0123456789 -"
+
+# Segment endpoints in a unit box (x right, y down)
+L, R, T, M, B = 0.18, 0.82, 0.10, 0.50, 0.90
+SEGMENTS = {
+    "a": ((L, T), (R, T)),
+    "b": ((R, T), (R, M)),
+    "c": ((R, M), (R, B)),
+    "d": ((L, B), (R, B)),
+    "e": ((L, M), (L, B)),
+    "f": ((L, T), (L, M)),
+    "g": ((L, M), (R, M)),
+}
+LIT = {
+    "0": "abcdef", "1": "bc", "2": "abdeg", "3": "abcdg", "4": "bcfg",
+    "5": "acdfg", "6": "acdefg", "7": "abc", "8": "abcdefg", "9": "abcdfg",
+    " ": "", "-": "g",
+}
+
+# name, width, height, stroke half-width in pixels
+FONTS = [
+    ("DIGITS_12X16", 12, 16, 1.0),
+    ("DIGITS_16X24", 16, 24, 1.4),
+]
+
+
+def dist_to_segment(px, py, ax, ay, bx, by):
+    dx, dy = bx - ax, by - ay
+    t = ((px - ax) * dx + (py - ay) * dy) / (dx * dx + dy * dy)
+    t = max(0.0, min(1.0, t))
+    return math.hypot(px - (ax + t * dx), py - (ay + t * dy))
+
+
+def rasterize(ch, w, h, half):
+    rows = []
+    for y in range(h):
+        row = []
+        for x in range(w):
+            px, py = x + 0.5, y + 0.5
+            on = False
+            for seg in LIT[ch]:
+                (ax, ay), (bx, by) = SEGMENTS[seg]
+                if dist_to_segment(px, py, ax * w, ay * h, bx * w, by * h) <= half:
+                    on = True
+                    break
+            row.append(on)
+        rows.append(row)
+    return rows
+
+
+def rle(bitmap):
+    runs = []
+    current, length = False, 0
+    for row in bitmap:
+        for on in row:
+            if on == current:
+                length += 1
+            else:
+                runs.append(length)
+                current, length = on, 1
+    runs.append(length)
+    out = []
+    for run in runs:
+        while run > 255:
+            out += [255, 0]
+            run -= 255
+        out.append(run)
+    return out
+
+
+def main():
+    print("// Generated by tools/gen_digits.py - do not edit by hand.")
+    print("// Run-length-encoded seven-segment glyphs, see tools/gen_digits.py for the format.")
+    print("#pragma once")
+    print()
+    print("#include <Arduino.h>")
+    print()
+    print('#define DIGIT_GLYPH_CHARSET "%s"' % CHARSET)
+    print()
+    for name, w, h, half in FONTS:
+        data, offsets = [], []
+        for ch in CHARSET:
+            offsets.append(len(data))
+            data += rle(rasterize(ch, w, h, half))
+        offsets.append(len(data))
+        print("// %dx%d, %d bytes" % (w, h, len(data)))
+        print("const uint8_t %s_WIDTH = %d;" % (name, w))
+        print("const uint8_t %s_HEIGHT = %d;" % (name, h))
+        print("const uint16_t %s_OFFSETS[] PROGMEM = { %s };" % (name, ", ".join(map(str, offsets))))
+        print("const uint8_t %s_DATA[] PROGMEM = {" % name)
+        for i in range(0, len(data), 16):
+            print("    " + ", ".join(map(str, data[i:i + 16])) + ",")
+        print("};")
+        print()
+
+
+if __name__ == "__main__":
+    main()
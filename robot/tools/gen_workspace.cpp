@@ -0,0 +1,77 @@
+// Generate include/workspace_map.h: the forbidden-zone bitmap for the workspace guard.
+//
+// Joint space (servo1..3, 0-180 deg) is cut into cubic cells of CELL_DEG per
+// axis, centered on multiples of CELL_DEG. A cell is forbidden when any of
+// SAMPLES^3 poses spread over it collides with the table or the base
+// (Obstacles in sim/arm_model.h, the same model the simulator scores against).
+//
+//   make -C tools workspace-map
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "sim/arm_model.h"
+
+static const int CELL_DEG = 10;
+static const int MAX_ANGLE = 180;
+static const int CELLS = MAX_ANGLE / CELL_DEG + 1;
+static const int SAMPLES = 5;
+
+static bool cellForbidden(const ArmGeometry &arm, const Obstacles &obstacles, int i, int j, int k) {
+    int cell[3] = { i, j, k };
+    double lo[3], hi[3];
+    for (int a = 0; a < 3; ++a) {
+        lo[a] = std::max(0.0, cell[a] * CELL_DEG - CELL_DEG / 2.0);
+        hi[a] = std::min((double)MAX_ANGLE, cell[a] * CELL_DEG + CELL_DEG / 2.0);
+    }
+    for (int a = 0; a < SAMPLES; ++a) {
+        for (int b = 0; b < SAMPLES; ++b) {
+            for (int c = 0; c < SAMPLES; ++c) {
+                double s1 = lo[0] + (hi[0] - lo[0]) * a / (SAMPLES - 1);
+                double s2 = lo[1] + (hi[1] - lo[1]) * b / (SAMPLES - 1);
+                double s3 = lo[2] + (hi[2] - lo[2]) * c / (SAMPLES - 1);
+                if (obstacles.collides(arm, s1, s2, s3)) return true;
+            }
+        }
+    }
+    return false;
+}
+
+int main() {
+    const ArmGeometry arm;
+    const Obstacles obstacles;
+    const int bits = CELLS * CELLS * CELLS;
+    std::vector<unsigned char> map((bits + 7) / 8, 0);
+    int forbidden = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        for (int j = 0; j < CELLS; ++j) {
+            for (int k = 0; k < CELLS; ++k) {
+                if (!cellForbidden(arm, obstacles, i, j, k)) continue;
+                int idx = (i * CELLS + j) * CELLS + k;
+                map[idx >> 3] |= 1 << (idx & 7);
+                forbidden++;
+            }
+        }
+    }
+
+    printf("// Generated by tools/gen_workspace.cpp - do not edit by hand.\n");
+    printf("// Forbidden joint-space cells (bit set = pose collides with the table or base).\n");
+    printf("// Arm: base %.0f, upper arm %.0f, forearm %.0f mm; base column r %.0f + %.0f mm; table clearance %.0f mm.\n",
+           arm.baseHeight, arm.upperArm, arm.forearm, obstacles.baseRadius, obstacles.baseClearance, obstacles.tableClearance);
+    printf("#pragma once\n\n#include <Arduino.h>\n\n");
+    printf("const uint8_t WORKSPACE_CELL_DEG = %d;\n", CELL_DEG);
+    printf("const uint8_t WORKSPACE_CELLS = %d;          // Per axis; cell i covers i*%d +/- %d deg\n",
+           CELLS, CELL_DEG, CELL_DEG / 2);
+    printf("// %d of %d cells forbidden, %u bytes; bit index = (c1 * %d + c2) * %d + c3, LSB first\n",
+           forbidden, bits, (unsigned)map.size(), CELLS, CELLS);
+    printf("const uint8_t WORKSPACE_MAP[] PROGMEM = {\n");
+    for (size_t i = 0; i < map.size(); i += 16) {
+        printf("   ");
+        for (size_t j = i; j < i + 16 && j < map.size(); ++j) printf(" 0x%02X,", map[j]);
+        printf("\n");
+    }
+    printf("};\n");
+    return 0;
+}
@@ -0,0 +1,80 @@
+// Host stand-in for Adafruit_GFX: no pixels are stored, but every primitive
+// counts the pixels and address windows it would send, so host benchmarks can
+// report bus work alongside CPU time.
+#pragma once
+
+#include <Arduino.h>
+
+struct HostTftStats {
+    unsigned long pixels;  // Pixels that would be clocked out
+    unsigned long windows; // Address windows opened
+    unsigned long calls;   // Drawing primitives invoked
+    unsigned long commands; // Panel commands sent with sendCommand()
+};
+extern HostTftStats hostTftStats;
+
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h) : _width(w), _height(h), rotation(0), cursor_x(0), cursor_y(0),
+        textsize_x(1), textsize_y(1), textcolor(0xFFFF), textbgcolor(0xFFFF) {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) { count(1, 1); }
+    virtual void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { if (w > 0 && h > 0) count((unsigned long)w * h, 1); }
+    virtual void fillScreen(uint16_t color) { fillRect(0, 0, _width, _height, color); }
+    virtual void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color) { fillRect(x, y, w, 1, color); }
+    virtual void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color) { fillRect(x, y, 1, h, color); }
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+        drawFastHLine(x, y, w, color); drawFastHLine(x, y + h - 1, w, color);
+        drawFastVLine(x, y, h, color); drawFastVLine(x + w - 1, y, h, color);
+    }
+    void fillCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color) {
+        // Like GFX: one vertical line per column pair
+        for (int16_t dx = -r; dx <= r; ++dx) {
+            int16_t dy = (int16_t)sqrt((double)(r * r - dx * dx));
+            drawFastVLine(x0 + dx, y0 - dy, 2 * dy + 1, color);
+        }
+    }
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+        // GFX draws each 5x7 cell pixel with fillRect (size > 1) or drawPixel, plus the spacing column;
+        // on the SPI panel each of those opens its own address window
+        if (size == 1) count(6 * 8, 6 * 8);
+        else count((unsigned long)6 * 8 * size * size, 6 * 8);
+        hostTftStats.windows += 6 * 8;
+    }
+    size_t write(uint8_t c) override {
+        if (c == '\n') { cursor_x = 0; cursor_y += textsize_y * 8; return 1; }
+        if (c == '\r') return 1;
+        drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, textsize_x);
+        cursor_x += textsize_x * 6;
+        return 1;
+    }
+    using Print::write;
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextSize(uint8_t s) { textsize_x = textsize_y = s; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void getTextBounds(const char* str, int16_t x, int16_t y, int16_t* x1, int16_t* y1, uint16_t* w, uint16_t* h) {
+        *x1 = x; *y1 = y; *w = strlen(str) * 6 * textsize_x; *h = 8 * textsize_y;
+    }
+    virtual void setRotation(uint8_t r) {
+        rotation = r & 3;
+        if (rotation & 1) { int16_t t = _width; _width = _height; _height = t; }
+    }
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+protected:
+    void count(unsigned long pixels, unsigned long calls) {
+        hostTftStats.pixels += pixels;
+        hostTftStats.calls += calls;
+    }
+
+    int16_t _width, _height;
+    uint8_t rotation;
+    int16_t cursor_x, cursor_y;
+    uint8_t textsize_x, textsize_y;
+    uint16_t textcolor, textbgcolor;
+};
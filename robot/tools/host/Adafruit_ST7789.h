@@ -0,0 +1,55 @@
+// Host stand-in for Adafruit_ST7789 (see Adafruit_GFX.h in this directory)
+#pragma once
+
+#include "Adafruit_GFX.h"
+
+#define ST77XX_BLACK   0x0000
+#define ST77XX_WHITE   0xFFFF
+#define ST77XX_RED     0xF800
+#define ST77XX_GREEN   0x07E0
+#define ST77XX_BLUE    0x001F
+#define ST77XX_CYAN    0x07FF
+#define ST77XX_MAGENTA 0xF81F
+#define ST77XX_YELLOW  0xFFE0
+#define ST77XX_ORANGE  0xFC00
+
+#define ST77XX_SWRESET 0x01
+#define ST77XX_SLPOUT  0x11
+#define ST77XX_NORON   0x13
+#define ST77XX_INVON   0x21
+#define ST77XX_DISPON  0x29
+#define ST77XX_CASET   0x2A
+#define ST77XX_RASET   0x2B
+#define ST77XX_RAMWR   0x2C
+#define ST77XX_MADCTL  0x36
+#define ST77XX_COLMOD  0x3A
+
+#define ST77XX_MADCTL_MY  0x80
+#define ST77XX_MADCTL_MX  0x40
+#define ST77XX_MADCTL_MV  0x20
+#define ST77XX_MADCTL_RGB 0x00
+
+class Adafruit_ST7789 : public Adafruit_GFX {
+public:
+    Adafruit_ST7789(int8_t cs, int8_t dc, int8_t mosi, int8_t sclk, int8_t rst = -1) : Adafruit_GFX(240, 320) {}
+
+    void init(uint16_t width, uint16_t height, uint8_t spiMode = 0) { _width = width; _height = height; }
+    void setRotation(uint8_t r) override {
+        rotation = r & 3;
+        _width = (rotation & 1) ? 320 : 240;
+        _height = (rotation & 1) ? 240 : 320;
+    }
+
+    void startWrite() {}
+    void endWrite() {}
+    virtual void setAddrWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) { hostTftStats.windows++; }
+    void writePixel(int16_t x, int16_t y, uint16_t color) { count(1, 1); }
+    void writeColor(uint16_t color, uint32_t len) { count(len, 1); }
+    void writePixels(uint16_t* colors, uint32_t len, bool block = true, bool bigEndian = false) { count(len, 1); }
+    void writeFillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) { fillRect(x, y, w, h, color); }
+    void sendCommand(uint8_t cmd, const uint8_t* data = NULL, uint8_t len = 0) { hostTftStats.commands++; }
+
+protected:
+    void begin(uint32_t freq = 0) {}
+    uint8_t _xstart = 0, _ystart = 0; // RAM offset of the visible area, set by setRotation() on the panel
+};
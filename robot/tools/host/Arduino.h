@@ -0,0 +1,69 @@
+// Minimal Arduino core for host builds of the firmware sources (simulator,
+// benchmarks). Only what src/ uses is provided; behaviour follows the AVR core.
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <type_traits>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define A0 14
+#define A1 15
+#define A2 16
+#define A3 17
+#define A4 18
+#define A5 19
+
+#define PI 3.1415926535897932384626433832795
+
+#define HOST_NUM_PINS 20
+
+// Program memory is ordinary memory on the host
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr)  (*(const uint8_t*)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_float(addr) (*(const float*)(addr))
+#define pgm_read_ptr(addr)   (*(const void* const*)(addr))
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+template <class A, class B> inline typename std::common_type<A, B>::type min(A a, B b) { return a < b ? a : b; }
+template <class A, class B> inline typename std::common_type<A, B>::type max(A a, B b) { return a > b ? a : b; }
+template <class T, class L, class H> inline T constrain(T x, L lo, H hi) { return x < lo ? lo : (x > hi ? hi : x); }
+// Same as the AVR core: rounds half away from zero and yields a long
+#define round(x) ((x) >= 0 ? (long)((x) + 0.5) : (long)((x) - 0.5))
+
+inline long map(long x, long inMin, long inMax, long outMin, long outMax) {
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+#include "Print.h"
+#include "HardwareSerial.h"
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+
+// Host EEPROM: 1 KB like the ATmega328P, erased to 0xFF
+class EEPROMClass {
+public:
+    EEPROMClass() { clear(); }
+    uint8_t read(int addr) const { return mem[addr]; }
+    void write(int addr, uint8_t value) { mem[addr] = value; writes++; }
+    void update(int addr, uint8_t value) { if (mem[addr] != value) write(addr, value); }
+    template <class T> T& get(int addr, T& t) const { memcpy(&t, &mem[addr], sizeof(T)); return t; }
+    template <class T> const T& put(int addr, const T& t) {
+        const uint8_t* p = (const uint8_t*)&t;
+        for (size_t i = 0; i < sizeof(T); ++i) update(addr + i, p[i]);
+        return t;
+    }
+    uint16_t length() const { return sizeof(mem); }
+    void clear() { memset(mem, 0xFF, sizeof(mem)); writes = 0; }
+
+    uint8_t mem[1024];
+    unsigned long writes; // Physical byte writes, to check wear in simulation
+};
+
+extern EEPROMClass EEPROM;
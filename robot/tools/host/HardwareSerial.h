@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Print.h"
+
+// Host serial port. Output goes to stdout when echo is enabled, otherwise it is dropped,
+// unless hostSerialAttach() bound it to a file descriptor. With hostSerialTxBuffer()
+// it also models the UART's TX buffer on the simulated clock.
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud);
+    void end() {}
+    int available();
+    int read();
+    int peek();
+    int availableForWrite();
+    void flush() {}
+    size_t write(uint8_t c) override;
+    using Print::write;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+class __FlashStringHelper;
+
+// Subset of the Arduino Print class; formatting matches the AVR core
+class Print {
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str);
+
+    size_t print(const __FlashStringHelper* str);
+    size_t print(const char* str);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = 10);
+    size_t print(int n, int base = 10);
+    size_t print(unsigned int n, int base = 10);
+    size_t print(long n, int base = 10);
+    size_t print(unsigned long n, int base = 10);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    template <class T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <class T> size_t println(T value, int format) { size_t n = print(value, format); return n + println(); }
+
+private:
+    size_t printNumber(unsigned long n, uint8_t base);
+};
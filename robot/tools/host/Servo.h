@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host Servo: records the commanded angle per pin for the simulator
+class Servo {
+public:
+    Servo() : pin(-1), angle(90) {}
+    uint8_t attach(int pin);
+    uint8_t attach(int pin, int minUs, int maxUs) { (void)minUs; (void)maxUs; return attach(pin); }
+    void detach();
+    void write(int value);
+    void writeMicroseconds(int us);
+    int read() const { return angle; }
+    bool attached() const { return pin >= 0; }
+
+private:
+    int pin;
+    int angle;
+};
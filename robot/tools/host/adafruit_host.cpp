@@ -0,0 +1,3 @@
+#include "Adafruit_GFX.h"
+
+HostTftStats hostTftStats;
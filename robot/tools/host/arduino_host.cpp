@@ -0,0 +1,231 @@
+#include <Arduino.h>
+#include <Servo.h>
+#include <EEPROM.h>
+#include <stdio.h>
+#include <string>
+#include <deque>
+#include <chrono>
+#include <unistd.h>
+#include "arduino_host.h"
+
+HardwareSerial Serial;
+EEPROMClass EEPROM;
+
+static uint64_t nowUs = 0;
+static int pinLevel[HOST_NUM_PINS];
+static int analogValue[HOST_NUM_PINS];
+static int servoAngle[HOST_NUM_PINS];
+static unsigned long servoWrites[HOST_NUM_PINS];
+static bool serialEcho = false;
+static std::string serialInput;
+
+static bool realtime = false;
+static long realtimeOffsetUs = 0;
+static double realtimeScale = 1.0;
+static uint64_t realtimeStartUs = 0;
+
+struct TxByte {
+    uint64_t dueUs; // When the stop bit has left the wire
+    uint8_t value;
+};
+static int serialFd = -1;
+static unsigned long serialBaud = 9600;
+static std::deque<TxByte> serialTx;
+static uint64_t serialLineFreeUs = 0;
+static bool serialTxModel = false;
+static const unsigned SERIAL_TX_BUFFER = 64;
+
+static uint64_t nowMicros() {
+    if (!realtime) return nowUs;
+    return (uint64_t)((hostMonotonicMicros() - realtimeStartUs) * realtimeScale) + realtimeOffsetUs;
+}
+
+void hostReset() {
+    nowUs = 0;
+    for (int i = 0; i < HOST_NUM_PINS; ++i) {
+        pinLevel[i] = HIGH; // Pull-ups: buttons released
+        analogValue[i] = 512; // Joystick centered
+        servoAngle[i] = -1;
+        servoWrites[i] = 0;
+    }
+    EEPROM.clear();
+    serialInput.clear();
+    serialLineFreeUs = 0;
+}
+
+void hostAdvanceMicros(uint64_t us) { nowUs += us; }
+uint64_t hostNowMicros() { return nowMicros(); }
+
+uint64_t hostMonotonicMicros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void hostUseRealtimeClock(long offsetUs, double ppm) {
+    realtime = true;
+    realtimeOffsetUs = offsetUs;
+    realtimeScale = 1.0 + ppm / 1e6;
+    realtimeStartUs = hostMonotonicMicros();
+}
+
+void hostSerialAttach(int fd) { serialFd = fd; }
+
+void hostSerialService() {
+    if (serialFd < 0) return;
+    uint64_t now = nowMicros();
+    while (!serialTx.empty() && serialTx.front().dueUs <= now) {
+        if (::write(serialFd, &serialTx.front().value, 1) != 1) break;
+        serialTx.pop_front();
+    }
+    char buf[256];
+    ssize_t n;
+    while ((n = ::read(serialFd, buf, sizeof(buf))) > 0) serialInput.append(buf, n);
+}
+
+void hostSetPin(uint8_t pin, int level) { pinLevel[pin] = level; }
+int hostGetPin(uint8_t pin) { return pinLevel[pin]; }
+void hostSetAnalog(uint8_t pin, int value) { analogValue[pin] = value; }
+
+int hostServoAngle(uint8_t pin) { return servoAngle[pin]; }
+unsigned long hostServoWrites(uint8_t pin) { return servoWrites[pin]; }
+
+void hostSerialEcho(bool enabled) { serialEcho = enabled; }
+void hostSerialFeed(const char* data, unsigned long len) { serialInput.append(data, len); }
+void hostSerialTxBuffer(bool enabled) { serialTxModel = enabled; }
+
+// --- Arduino core ---
+unsigned long millis() { return (unsigned long)(nowMicros() / 1000); }
+unsigned long micros() { return (unsigned long)nowMicros(); }
+
+void delay(unsigned long ms) { delayMicroseconds(ms * 1000); }
+
+void delayMicroseconds(unsigned int us) {
+    if (!realtime) {
+        nowUs += us;
+        return;
+    }
+    uint64_t end = nowMicros() + us;
+    while (nowMicros() < end) hostSerialService();
+}
+
+void pinMode(uint8_t pin, uint8_t mode) { if (mode == INPUT_PULLUP) pinLevel[pin] = HIGH; }
+void digitalWrite(uint8_t pin, uint8_t value) { pinLevel[pin] = value ? HIGH : LOW; }
+int digitalRead(uint8_t pin) { return pinLevel[pin]; }
+int analogRead(uint8_t pin) { return analogValue[pin]; }
+
+// --- Servo ---
+uint8_t Servo::attach(int p) {
+    pin = p;
+    servoAngle[pin] = angle;
+    return 0;
+}
+
+void Servo::detach() { pin = -1; }
+
+void Servo::write(int value) {
+    if (value >= 544) { // Like the AVR library: large values are pulse widths
+        writeMicroseconds(value);
+        return;
+    }
+    angle = constrain(value, 0, 180);
+    if (pin >= 0) {
+        servoAngle[pin] = angle;
+        servoWrites[pin]++;
+    }
+}
+
+void Servo::writeMicroseconds(int us) {
+    write((int)map(constrain(us, 544, 2400), 544, 2400, 0, 180));
+}
+
+// --- Serial ---
+void HardwareSerial::begin(unsigned long baud) { serialBaud = baud; }
+
+int HardwareSerial::available() {
+    hostSerialService();
+    return (int)serialInput.size();
+}
+
+int HardwareSerial::read() {
+    if (serialInput.empty()) return -1;
+    int c = (uint8_t)serialInput[0];
+    serialInput.erase(0, 1);
+    return c;
+}
+
+int HardwareSerial::peek() { return serialInput.empty() ? -1 : (uint8_t)serialInput[0]; }
+
+static uint64_t serialByteUs() { return 10000000ULL / serialBaud; }
+
+// Bytes still in the TX buffer or on the wire (simulated clock)
+static unsigned serialTxPending() {
+    uint64_t now = nowMicros();
+    if (serialLineFreeUs <= now) return 0;
+    return (unsigned)((serialLineFreeUs - now + serialByteUs() - 1) / serialByteUs());
+}
+
+int HardwareSerial::availableForWrite() {
+    if (!serialTxModel || serialFd >= 0) return SERIAL_TX_BUFFER - 1;
+    unsigned pending = serialTxPending();
+    return pending >= SERIAL_TX_BUFFER - 1 ? 0 : (int)(SERIAL_TX_BUFFER - 1 - pending);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    if (serialTxModel && serialFd < 0 && !realtime) {
+        // Full: wait for the oldest byte to leave, as the AVR core's write() does
+        if (serialTxPending() >= SERIAL_TX_BUFFER) nowUs = serialLineFreeUs - (SERIAL_TX_BUFFER - 1) * serialByteUs();
+        serialLineFreeUs = std::max(nowUs, serialLineFreeUs) + serialByteUs();
+    }
+    if (serialFd >= 0) {
+        // Queued like a UART shift register: one byte every 10 bit times
+        uint64_t start = std::max(nowMicros(), serialLineFreeUs);
+        serialLineFreeUs = start + 10000000ULL / serialBaud;
+        serialTx.push_back({ serialLineFreeUs, c });
+        return 1;
+    }
+    if (serialEcho) fputc(c, stdout);
+    return 1;
+}
+
+// --- Print ---
+size_t Print::write(const uint8_t* buffer, size_t size) {
+    size_t n = 0;
+    while (size--) n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char* str) { return write((const uint8_t*)str, strlen(str)); }
+size_t Print::print(const __FlashStringHelper* str) { return write((const char*)str); }
+size_t Print::print(const char* str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t)c); }
+size_t Print::print(unsigned char n, int base) { return print((unsigned long)n, base); }
+size_t Print::print(int n, int base) { return print((long)n, base); }
+size_t Print::print(unsigned int n, int base) { return print((unsigned long)n, base); }
+
+size_t Print::print(long n, int base) {
+    if (base == 10 && n < 0) return print('-') + printNumber((unsigned long)-n, 10);
+    return printNumber((unsigned long)n, base);
+}
+
+size_t Print::print(unsigned long n, int base) { return printNumber(n, base); }
+
+size_t Print::print(double n, int digits) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", digits, n);
+    return write(buf);
+}
+
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+    char buf[8 * sizeof(long) + 1];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = '\0';
+    if (base < 2) base = 10;
+    do {
+        char c = n % base;
+        n /= base;
+        *--str = c < 10 ? c + '0' : c + 'A' - 10;
+    } while (n);
+    return write(str);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdint.h>
+
+// Controls for the host Arduino core (time, pins, servos, serial)
+
+void hostReset();                          // Time 0, pins released, EEPROM erased
+void hostAdvanceMicros(uint64_t us);
+uint64_t hostNowMicros();
+
+void hostSetPin(uint8_t pin, int level);   // Drive an input (buttons: LOW = pressed)
+int hostGetPin(uint8_t pin);               // Level last written or driven
+void hostSetAnalog(uint8_t pin, int value);
+
+int hostServoAngle(uint8_t pin);           // Last commanded angle, -1 if never commanded
+unsigned long hostServoWrites(uint8_t pin);
+
+void hostSerialEcho(bool enabled);         // Copy Serial output to stdout
+void hostSerialFeed(const char* data, unsigned long len); // Bytes returned by Serial.read()
+// Simulated clock: a 64-byte TX buffer drained at the Serial.begin() baud rate
+// (default 9600). availableForWrite() reports the free space, and write() on a
+// full buffer waits like the AVR core does, advancing micros() until a byte is out.
+void hostSerialTxBuffer(bool enabled);
+
+// Real-time mode for multi-process tests (tools/link): micros() follows the
+// monotonic clock, scaled by (1 + ppm / 1e6) and shifted by offsetUs to mimic
+// an unsynchronized board, and Serial is bound to a file descriptor (a pty)
+// with bytes released at the configured baud rate.
+void hostUseRealtimeClock(long offsetUs, double ppm);
+uint64_t hostMonotonicMicros();            // Unscaled, shared by all processes on the machine
+void hostSerialAttach(int fd);
+void hostSerialService();                  // Move bytes between the fd and Serial; call every loop pass
@@ -0,0 +1,193 @@
+#!/usr/bin/env python3
+"""Multi-drop UART bus over pseudo-terminals, for testing the link on Linux.
+
+Starts one master node and N slave nodes (native firmware builds, see
+node.cpp), each on its own pty. The hub copies the master's TX to every
+slave and every slave's TX to the master, like a shared RS-485/TTL bus.
+Each node gets a random clock offset and drift. When the run ends, the servo
+logs are compared: every pose the master commanded must appear on each
+slave, and the time between the two is the start skew. The bytes each node
+sent are checked too: the master may send only well-formed frames, and the
+slaves nothing at all (debug text on the link UART fails the run).
+
+    make -C tools run-link
+    python3 tools/link/link_bus.py --master tools/build/node_master \\
+        --slave tools/build/node_slave --slaves 2 --run-ms 6000
+"""
+
+import argparse
+import os
+import random
+import select
+import statistics
+import subprocess
+import sys
+import tempfile
+import tty
+
+WARMUP_US = 1500000      # Boot and the first heartbeats are not scored
+MATCH_LOOKAHEAD = 20     # Poses searched ahead when the slave missed some
+
+# Frame layout, include/link.h
+LINK_SOF = 0x7E
+LINK_HEADER_BYTES = 8    # addr type seq len ts[4]
+LINK_MAX_PAYLOAD = 16
+
+
+def open_port():
+    hub_fd, node_fd = os.openpty()
+    tty.setraw(hub_fd)
+    tty.setraw(node_fd)  # Raw before the node opens it, so nothing is echoed back
+    os.set_blocking(hub_fd, False)
+    return hub_fd, node_fd, os.ttyname(node_fd)
+
+
+def load_log(path):
+    entries = []
+    with open(path) as f:
+        for line in f:
+            parts = line.split()
+            if len(parts) == 4:
+                entries.append((int(parts[0]), tuple(int(p) for p in parts[1:])))
+    return entries
+
+
+def crc16(data):
+    """CRC-16/CCITT, as include/crc16.h."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def split_frames(data):
+    """Walk a node's TX stream; returns (frames, stray bytes outside any valid frame).
+
+    A frame cut off by the end of the capture (the node stops at --run-ms,
+    possibly mid-frame) is not stray.
+    """
+    frames = stray = i = 0
+    while i < len(data):
+        if data[i] == LINK_SOF:
+            if i + 1 + LINK_HEADER_BYTES > len(data):
+                break
+            length = data[i + 4]
+            end = i + 1 + LINK_HEADER_BYTES + length + 2
+            if length <= LINK_MAX_PAYLOAD and end > len(data):
+                break
+            if length <= LINK_MAX_PAYLOAD:
+                body = data[i + 1:end - 2]
+                if crc16(body) == data[end - 2] | data[end - 1] << 8:
+                    frames += 1
+                    i = end
+                    continue
+        stray += 1
+        i += 1
+    return frames, stray
+
+
+def match_skews(master, slave, start_us):
+    """Pair the master's poses with the slave's in order; returns skews in us and the match count."""
+    skews = []
+    j = 0
+    for t, pose in master:
+        for k in range(j, min(j + MATCH_LOOKAHEAD, len(slave))):
+            if slave[k][1] == pose:
+                if t >= start_us:
+                    skews.append(slave[k][0] - t)
+                j = k + 1
+                break
+    scored = sum(1 for t, _ in master if t >= start_us)
+    return skews, scored
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--master", required=True, help="node_master binary")
+    ap.add_argument("--slave", required=True, help="node_slave binary")
+    ap.add_argument("--slaves", type=int, default=2)
+    ap.add_argument("--run-ms", type=int, default=6000)
+    ap.add_argument("--max-skew-us", type=int, default=2000, help="fail above this start skew")
+    ap.add_argument("--seed", type=int, default=None)
+    args = ap.parse_args()
+    rng = random.Random(args.seed)
+
+    ports = [open_port() for _ in range(args.slaves + 1)]
+    logdir = tempfile.mkdtemp(prefix="link_bus_")
+    procs = []
+    for i, (_, _, path) in enumerate(ports):
+        is_master = i == 0
+        cmd = [args.master if is_master else args.slave, "--serial", path,
+               "--run-ms", str(args.run_ms + (0 if is_master else 500)),
+               # Boards power up at different times and their resonators disagree
+               "--clock-offset-us", str(rng.randrange(0, 1 << 31)),
+               "--clock-ppm", str(rng.uniform(-2000, 2000)),
+               "--log", os.path.join(logdir, "node%d.log" % i)]
+        if is_master:
+            cmd += ["--joy", "circle"]
+        procs.append(subprocess.Popen(cmd))
+
+    master_fd = ports[0][0]
+    slave_fds = [p[0] for p in ports[1:]]
+    sent = {fd: bytearray() for fd in [master_fd] + slave_fds}
+    while procs[0].poll() is None:
+        ready, _, _ = select.select([master_fd] + slave_fds, [], [], 0.05)
+        for fd in ready:
+            try:
+                data = os.read(fd, 4096)
+            except (BlockingIOError, OSError):
+                continue
+            sent[fd] += data
+            targets = slave_fds if fd == master_fd else [master_fd]
+            for target in targets:
+                try:
+                    os.write(target, data)
+                except BlockingIOError:
+                    pass  # Node not reading: a real bus drops the bytes too
+    for p in procs:
+        p.wait()
+    while True:  # The master's last writes may still sit in its pty
+        try:
+            data = os.read(master_fd, 4096)
+        except (BlockingIOError, OSError):
+            break
+        if not data:
+            break
+        sent[master_fd] += data
+
+    master = load_log(os.path.join(logdir, "node0.log"))
+    if not master:
+        print("link_bus: master commanded no poses")
+        return 1
+    start_us = master[0][0] + WARMUP_US
+    failed = False
+    print("%-8s %8s %8s %9s %9s %9s" % ("node", "matched", "scored", "p50_us", "p99_us", "max_us"))
+    for i in range(1, args.slaves + 1):
+        skews, scored = match_skews(master, load_log(os.path.join(logdir, "node%d.log" % i)), start_us)
+        if not skews:
+            print("slave%-3d %8d %8d %9s %9s %9s" % (i, 0, scored, "-", "-", "-"))
+            failed = True
+            continue
+        abs_skews = sorted(abs(s) for s in skews)
+        p50 = statistics.median(skews)
+        p99 = abs_skews[min(len(abs_skews) - 1, int(len(abs_skews) * 0.99))]
+        worst = abs_skews[-1]
+        print("slave%-3d %8d %8d %9.0f %9d %9d" % (i, len(skews), scored, p50, p99, worst))
+        if len(skews) < 0.95 * scored or p99 > args.max_skew_us:
+            failed = True
+    frames, stray = split_frames(sent[master_fd])
+    print("wire: master %d frames, %d stray bytes" % (frames, stray))
+    if stray:
+        failed = True
+    for i, fd in enumerate(slave_fds, 1):
+        if sent[fd]:
+            print("wire: slave%d sent %d bytes, slaves must not transmit" % (i, len(sent[fd])))
+            failed = True
+    print("logs in %s" % logdir)
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,105 @@
+// One arm as a native process for link tests: runs the firmware's setup()/loop()
+// in real time with Serial bound to a pty (see link_bus.py, which wires several
+// nodes into a multi-drop bus). Built twice, as node_master and node_slave.
+//
+//   node --serial /dev/pts/N [--run-ms N] [--clock-offset-us N] [--clock-ppm N]
+//        [--joy circle] [--log FILE]
+//
+// The log has one line per change of the commanded servo angles:
+//   <monotonic us> <servo1> ... <servoN>   (N = ARM_AXES)
+// Monotonic time is shared by every process on the machine, so logs from
+// different nodes can be compared directly.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "arduino_host.h"
+#include "control.h"
+#include "link.h"
+
+void setup();
+void loop();
+
+static const double JOY_CIRCLE_PERIOD_MS = 3000.0;
+
+static int openPty(const char* path) {
+    int fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+    if (fd < 0) return -1;
+    termios tio;
+    if (tcgetattr(fd, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(fd, TCSANOW, &tio);
+    }
+    return fd;
+}
+
+int main(int argc, char** argv) {
+    const char* serialPath = NULL;
+    const char* logPath = NULL;
+    long runMs = 5000, clockOffsetUs = 0;
+    double clockPpm = 0.0;
+    bool joyCircle = false;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (!strcmp(argv[i], "--serial") && hasValue) serialPath = argv[++i];
+        else if (!strcmp(argv[i], "--log") && hasValue) logPath = argv[++i];
+        else if (!strcmp(argv[i], "--run-ms") && hasValue) runMs = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--clock-offset-us") && hasValue) clockOffsetUs = atol(argv[++i]);
+        else if (!strcmp(argv[i], "--clock-ppm") && hasValue) clockPpm = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--joy") && hasValue) joyCircle = !strcmp(argv[++i], "circle");
+        else {
+            fprintf(stderr, "usage: %s --serial PTY [--run-ms N] [--clock-offset-us N] [--clock-ppm N] [--joy circle] [--log FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+    int fd = serialPath ? openPty(serialPath) : -1;
+    if (fd < 0) {
+        fprintf(stderr, "node: cannot open serial port %s\n", serialPath ? serialPath : "(none)");
+        return 1;
+    }
+    FILE* log = logPath ? fopen(logPath, "w") : NULL;
+
+    hostReset();
+    hostUseRealtimeClock(clockOffsetUs, clockPpm);
+    hostSerialAttach(fd);
+    setup();
+
+    int logged[ARM_AXES];
+    for (int j = 0; j < ARM_AXES; ++j) logged[j] = -2;
+    uint64_t startUs = hostMonotonicMicros();
+    for (;;) {
+        uint64_t elapsedUs = hostMonotonicMicros() - startUs;
+        if (elapsedUs >= (uint64_t)runMs * 1000) break;
+        if (joyCircle) {
+            // Full deflection swept around the circle, after a second at rest
+            double t = elapsedUs / 1000.0 - 1000.0;
+            bool active = t > 0;
+            double a = 2.0 * M_PI * t / JOY_CIRCLE_PERIOD_MS;
+            hostSetAnalog(JOYSTICK_X_PIN, active ? (int)(512 + 511 * cos(a)) : 512);
+            hostSetAnalog(JOYSTICK_Y_PIN, active ? (int)(512 + 511 * sin(a)) : 512);
+        }
+        loop();
+        hostSerialService();
+
+        int angles[ARM_AXES];
+        for (int j = 0; j < ARM_AXES; ++j) angles[j] = hostServoAngle(SERVO_PINS[j]);
+        if (log && memcmp(angles, logged, sizeof(angles)) != 0) {
+            fprintf(log, "%llu", (unsigned long long)hostMonotonicMicros());
+            for (int j = 0; j < ARM_AXES; ++j) fprintf(log, " %d", angles[j]);
+            fprintf(log, "\n");
+            memcpy(logged, angles, sizeof(logged));
+        }
+        usleep(20);
+    }
+
+    fprintf(stderr, "node %s: sent %lu received %lu crc_errors %lu seq_gaps %lu late %lu offset_us %ld\n",
+            LINK_ROLE == LINK_MASTER ? "master" : "slave", linkStats.framesSent, linkStats.framesReceived,
+            linkStats.crcErrors, linkStats.seqGaps, linkStats.lateApplies, linkStats.offsetUs);
+    if (log) fclose(log);
+    return 0;
+}
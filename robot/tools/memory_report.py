@@ -0,0 +1,102 @@
+# PlatformIO extra script: static RAM/flash report and budget check.
+#
+# After every link it prints section totals and the largest SRAM symbols, and
+# fails the build when a budget from platformio.ini is exceeded:
+#   custom_sram_budget  = bytes of .data + .bss + .noinit allowed (the rest is stack)
+#   custom_flash_budget = bytes of .text + .data allowed
+# `pio run -t memreport` prints every symbol, SRAM and flash, largest first.
+
+Import("env")
+
+import subprocess
+import sys
+
+SRAM_BASE = 0x800000    # avr-gcc maps data memory at this offset in the ELF
+EEPROM_BASE = 0x810000  # .eeprom, then fuses and lock bits above it: not SRAM
+TOP_SYMBOLS = 15
+
+
+def tool(name):
+    # avr-objcopy is always set by the atmelavr platform; derive its siblings from it
+    return env.subst("$OBJCOPY").replace("objcopy", name)
+
+
+def section_sizes(elf):
+    out = subprocess.check_output([tool("size"), "-A", elf], universal_newlines=True)
+    sizes = {}
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) >= 2 and parts[0].startswith(".") and parts[1].isdigit():
+            sizes[parts[0]] = int(parts[1])
+    return sizes
+
+
+def symbols(elf):
+    out = subprocess.check_output([tool("nm"), "-C", "-S", "--size-sort", "-t", "d", elf],
+                                  universal_newlines=True)
+    ram, flash = [], []
+    for line in out.splitlines():
+        parts = line.split(None, 3)
+        if len(parts) < 4:
+            continue
+        addr, size, kind, name = int(parts[0]), int(parts[1]), parts[2], parts[3]
+        if SRAM_BASE <= addr < EEPROM_BASE:
+            ram.append((size, kind, name))
+        elif addr < SRAM_BASE:
+            flash.append((size, kind, name))
+    ram.sort(reverse=True)
+    flash.sort(reverse=True)
+    return ram, flash
+
+
+def budget(option):
+    value = env.GetProjectOption(option, "")
+    return int(value) if value else None
+
+
+def print_table(title, rows, limit=None):
+    print("  %s" % title)
+    for size, kind, name in rows[:limit]:
+        print("    %6d  %s  %s" % (size, kind, name))
+
+
+def check_budgets(source, target, env):
+    elf = str(target[0])
+    sizes = section_sizes(elf)
+    ram_static = sizes.get(".data", 0) + sizes.get(".bss", 0) + sizes.get(".noinit", 0)
+    flash_used = sizes.get(".text", 0) + sizes.get(".data", 0)
+    ram, _ = symbols(elf)
+
+    sram_budget = budget("custom_sram_budget")
+    flash_budget = budget("custom_flash_budget")
+    print("Memory: SRAM static %d B (.data %d, .bss %d, .noinit %d)%s, flash %d B%s" % (
+        ram_static, sizes.get(".data", 0), sizes.get(".bss", 0), sizes.get(".noinit", 0),
+        " / budget %d" % sram_budget if sram_budget else "",
+        flash_used, " / budget %d" % flash_budget if flash_budget else ""))
+    print_table("largest SRAM symbols:", ram, TOP_SYMBOLS)
+
+    failed = False
+    if sram_budget and ram_static > sram_budget:
+        sys.stderr.write("Error: static SRAM %d B exceeds custom_sram_budget %d B\n" % (ram_static, sram_budget))
+        failed = True
+    if flash_budget and flash_used > flash_budget:
+        sys.stderr.write("Error: flash %d B exceeds custom_flash_budget %d B\n" % (flash_used, flash_budget))
+        failed = True
+    if failed:
+        env.Exit(1)
+
+
+def full_report(source, target, env):
+    elf = env.subst("$BUILD_DIR/${PROGNAME}.elf")
+    ram, flash = symbols(elf)
+    print_table("SRAM symbols (%d B):" % sum(r[0] for r in ram), ram)
+    print_table("Flash symbols (%d B):" % sum(f[0] for f in flash), flash)
+
+
+env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", check_budgets)
+env.AddCustomTarget(
+    name="memreport",
+    dependencies="$BUILD_DIR/${PROGNAME}.elf",
+    actions=[full_report],
+    title="Memory report",
+    description="Per-symbol SRAM and flash usage")
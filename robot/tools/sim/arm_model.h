@@ -0,0 +1,95 @@
+// Plant model for the host simulator: servo dynamics and arm kinematics.
+// Header-only so other host tools can share the same geometry.
+#pragma once
+
+#include <cmath>
+
+// Hobby servo: second-order response to the commanded angle with a slew-rate limit
+struct ServoModel {
+    double angle = 0.0;       // Actual shaft angle (deg)
+    double velocity = 0.0;    // deg/s
+    double slewLimit = 400.0; // Max speed (deg/s); SG90 class is ~500 deg/s unloaded
+    double naturalFreq = 30.0;// rad/s
+    double damping = 0.7;     // Below 1 gives a small overshoot, as with a loaded arm
+
+    void step(double commanded, double dt) {
+        double accel = naturalFreq * naturalFreq * (commanded - angle) - 2.0 * damping * naturalFreq * velocity;
+        velocity += accel * dt;
+        if (velocity > slewLimit) velocity = slewLimit;
+        if (velocity < -slewLimit) velocity = -slewLimit;
+        angle += velocity * dt;
+    }
+};
+
+struct Vec3 {
+    double x, y, z;
+};
+
+// Simple 3-link arm (mm):
+//  servo1 - base yaw, servo angle = yaw angle
+//  servo2 - shoulder pitch from horizontal (0 = forward, 180 = backward)
+//  servo3 - elbow; 180 = forearm in line with the upper arm, lower values fold it down
+struct ArmGeometry {
+    double baseHeight = 70.0;
+    double upperArm = 100.0;
+    double forearm = 110.0;
+
+    static double rad(double deg) { return deg * M_PI / 180.0; }
+
+    // Shoulder, elbow and tool positions for the given servo angles
+    void forward(double s1, double s2, double s3, Vec3 &elbow, Vec3 &tool) const {
+        double yaw = rad(s1);
+        double a2 = rad(s2);
+        double a3 = a2 + rad(s3) - M_PI;
+        double r2 = upperArm * std::cos(a2);
+        double z2 = baseHeight + upperArm * std::sin(a2);
+        double r3 = r2 + forearm * std::cos(a3);
+        double z3 = z2 + forearm * std::sin(a3);
+        elbow = { r2 * std::cos(yaw), r2 * std::sin(yaw), z2 };
+        tool = { r3 * std::cos(yaw), r3 * std::sin(yaw), z3 };
+    }
+
+    Vec3 tool(double s1, double s2, double s3) const {
+        Vec3 elbow, t;
+        forward(s1, s2, s3, elbow, t);
+        return t;
+    }
+};
+
+inline double distance(const Vec3 &a, const Vec3 &b) {
+    return std::sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y) + (a.z - b.z) * (a.z - b.z));
+}
+
+// Distance from p to the segment a-b
+inline double distanceToSegment(const Vec3 &p, const Vec3 &a, const Vec3 &b) {
+    Vec3 ab = { b.x - a.x, b.y - a.y, b.z - a.z };
+    double len2 = ab.x * ab.x + ab.y * ab.y + ab.z * ab.z;
+    if (len2 == 0.0) return distance(p, a);
+    double t = ((p.x - a.x) * ab.x + (p.y - a.y) * ab.y + (p.z - a.z) * ab.z) / len2;
+    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+    Vec3 q = { a.x + t * ab.x, a.y + t * ab.y, a.z + t * ab.z };
+    return distance(p, q);
+}
+
+// What the arm can hit: the table it stands on (z = 0) and its own base column,
+// a cylinder around the yaw axis from the table up to the shoulder
+struct Obstacles {
+    double tableClearance = 0.0;  // Elbow, forearm and tool must stay this high (mm)
+    double baseRadius = 40.0;
+    double baseClearance = 5.0;   // Extra margin around the base column
+
+    bool collides(const ArmGeometry &arm, double s1, double s2, double s3) const {
+        const int FOREARM_SAMPLES = 8;
+        Vec3 elbow, tool;
+        arm.forward(s1, s2, s3, elbow, tool);
+        if (elbow.z < tableClearance) return true;
+        for (int i = 0; i <= FOREARM_SAMPLES; ++i) {
+            double t = (double)i / FOREARM_SAMPLES;
+            Vec3 p = { elbow.x + t * (tool.x - elbow.x), elbow.y + t * (tool.y - elbow.y), elbow.z + t * (tool.z - elbow.z) };
+            if (p.z < tableClearance) return true;
+            bool inColumn = std::sqrt(p.x * p.x + p.y * p.y) < baseRadius + baseClearance;
+            if (inColumn && p.z < arm.baseHeight + baseClearance) return true;
+        }
+        return false;
+    }
+};
@@ -0,0 +1,377 @@
+// Host-side closed-loop simulator: runs the firmware control logic (src/control.cpp)
+// against scripted joystick/button traces, a servo dynamics model and a 3-link arm.
+// Each tick also runs the serial reports against a 9600-baud TX buffer, so a
+// report that blocks the loop is counted in the overruns column.
+//
+//   make -C tools sim && tools/build/sim tools/sim/scenarios/*.scn
+//   tools/build/sim --trace trace.txt scenario.scn   also dump the event trace (include/trace.h)
+//                                                    for tools/trace2perfetto.py
+//
+// Scenario file format (one directive per line, '#' starts a comment):
+//   pose <s1> <s2> <s3>        pose saved in EEPROM at boot (default: erased EEPROM)
+//   servo_slew <deg/s>         servo slew-rate limit (default 400)
+//   profile <index>            motion profile active at boot (default 0, see config.cpp)
+//   at <ms> joy <x> <y>        raw joystick readings from this time on (0..1023)
+//   at <ms> press <BUTTON>     button pressed (UP, DOWN, MOS_CTRL, CENTER)
+//   at <ms> release <BUTTON>
+//   at <ms> stall <ms>         loop() stuck in a display step: no control ticks for that long
+//   end <ms>                   simulated duration
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "arm_model.h"
+#include "arduino_host.h"
+#include <EEPROM.h>
+#include "control.h"
+#include "config.h"
+#include "supervisor.h"
+#include "memwatch.h"
+#include "trace.h"
+
+static_assert(ARM_AXES == 3, "the arm model (arm_model.h) has three joints");
+
+static const double SIM_DT_US = 1000.0;       // Plant integration step
+static const double SETTLE_TOLERANCE_DEG = 1.0;
+static const double MOVING_THRESHOLD_DEG_S = 2.0;
+
+struct Event {
+    unsigned long atMs;
+    enum Kind { JOY, PRESS, RELEASE, STALL } kind;
+    int a, b;
+};
+
+struct Scenario {
+    std::string name;
+    bool hasPose = false;
+    int pose[3] = { 0, 0, 0 };
+    int profile = 0;
+    double servoSlew = 400.0;
+    unsigned long endMs = 3000;
+    std::vector<Event> events;
+};
+
+struct Metrics {
+    double settleMs = -1.0;   // After the last input event; < 0 = not settled at end
+    double overshootDeg = 0.0;
+    double pathErrorMm = 0.0; // Max deviation of the tool from the start-end straight line
+    double travelMm = 0.0;
+    double meanSpeedMmS = 0.0;
+    double trackErrorDeg = 0.0; // Max |commanded - actual|
+    double commitsPerS = 0.0;
+    double collideMs = 0.0;   // Time the modeled arm spent inside the table or base
+    unsigned long overruns = 0; // Supervisor stage overruns (include/supervisor.h)
+};
+
+static int buttonPin(const std::string &name) {
+    for (size_t i = 0; i < NUM_BUTTONS; ++i) {
+        if (name == flashPtr(buttons[i].name)) return buttons[i].pin;
+    }
+    return -1;
+}
+
+static bool loadScenario(const char* path, Scenario &sc) {
+    std::ifstream in(path);
+    if (!in) {
+        fprintf(stderr, "sim: cannot open %s\n", path);
+        return false;
+    }
+    std::string base = path;
+    size_t slash = base.find_last_of('/');
+    if (slash != std::string::npos) base = base.substr(slash + 1);
+    sc.name = base.substr(0, base.find('.'));
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        line = line.substr(0, line.find('#'));
+        std::istringstream ss(line);
+        std::string word;
+        if (!(ss >> word)) continue;
+        bool ok = true;
+        if (word == "pose") {
+            ok = bool(ss >> sc.pose[0] >> sc.pose[1] >> sc.pose[2]);
+            sc.hasPose = true;
+        } else if (word == "profile") {
+            ok = bool(ss >> sc.profile) && sc.profile >= 0 && sc.profile < NUM_PROFILES;
+        } else if (word == "servo_slew") {
+            ok = bool(ss >> sc.servoSlew);
+        } else if (word == "end") {
+            ok = bool(ss >> sc.endMs);
+        } else if (word == "at") {
+            Event ev;
+            std::string kind;
+            ok = bool(ss >> ev.atMs >> kind);
+            if (ok && kind == "joy") {
+                ev.kind = Event::JOY;
+                ok = bool(ss >> ev.a >> ev.b);
+            } else if (ok && (kind == "press" || kind == "release")) {
+                std::string button;
+                ev.kind = kind == "press" ? Event::PRESS : Event::RELEASE;
+                ok = bool(ss >> button);
+                ev.a = buttonPin(button);
+                ok = ok && ev.a >= 0;
+            } else if (ok && kind == "stall") {
+                ev.kind = Event::STALL;
+                ok = bool(ss >> ev.a);
+            } else {
+                ok = false;
+            }
+            if (ok) sc.events.push_back(ev);
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            fprintf(stderr, "sim: %s:%d: cannot parse '%s'\n", path, lineNo, line.c_str());
+            return false;
+        }
+    }
+    std::stable_sort(sc.events.begin(), sc.events.end(),
+                     [](const Event &x, const Event &y) { return x.atMs < y.atMs; });
+    return true;
+}
+
+static void seedSavedPose(const Scenario &sc) {
+    if (!sc.hasPose) return;
+    byte s1 = sc.pose[0], s2 = sc.pose[1], s3 = sc.pose[2];
+    EEPROM.write(POSE_EEPROM_ADDR, POSE_EEPROM_MAGIC);
+    EEPROM.write(POSE_EEPROM_ADDR + 1, s1);
+    EEPROM.write(POSE_EEPROM_ADDR + 2, s2);
+    EEPROM.write(POSE_EEPROM_ADDR + 3, s3);
+    EEPROM.write(POSE_EEPROM_ADDR + 4, s1 ^ s2 ^ s3 ^ POSE_EEPROM_MAGIC);
+}
+
+// Saved selection, as written by the UP+DOWN chord
+static void seedProfileSelection(const Scenario &sc) {
+    EEPROM.write(PROFILE_SELECT_EEPROM_ADDR, sc.profile);
+    EEPROM.write(PROFILE_SELECT_EEPROM_ADDR + 1, (byte)~sc.profile);
+}
+
+struct Sample {
+    double tMs;
+    double actual[3];
+    int commanded[3];
+    Vec3 tool;
+};
+
+static Metrics runScenario(const Scenario &sc, FILE* csv) {
+    const ArmGeometry arm;
+    Obstacles contact; // Physical contact, without the margin the guard map is built with
+    contact.baseClearance = 0.0;
+
+    hostReset();
+    seedSavedPose(sc);
+    seedProfileSelection(sc);
+    for (int j = 0; j < ARM_AXES; ++j) currentServoPos[j] = 180.0f; // Firmware power-on defaults
+    servoCommitCount = 0;
+    lastServoMoveMs = 0;
+    for (size_t i = 0; i < NUM_BUTTONS; ++i) {
+        buttons[i].stableState = buttons[i].lastReading = HIGH;
+        buttons[i].lastChangeTime = 0;
+        buttons[i].actionTakenOnPress = false;
+    }
+    supervisorSetup();
+    controlSetup();
+    supervisorStart();
+
+    // The arm physically rests at the saved pose, or wherever the first command puts it
+    ServoModel servos[3];
+    for (int j = 0; j < 3; ++j) {
+        servos[j].slewLimit = sc.servoSlew;
+        servos[j].angle = sc.hasPose ? sc.pose[j] : hostServoAngle(SERVO_PINS[j]);
+    }
+
+    std::vector<Sample> samples;
+    size_t nextEvent = 0;
+    unsigned long lastInputMs = 0;
+    const unsigned long tickUs = SERVO_UPDATE_RATE * 1000UL;
+    unsigned long long nextTickUs = 0;
+    unsigned long long stallEndUs = 0;
+    bool stalled = false;
+
+    for (unsigned long long t = 0; t <= (unsigned long long)sc.endMs * 1000; t += (unsigned long long)SIM_DT_US) {
+        unsigned long nowMs = t / 1000;
+        while (nextEvent < sc.events.size() && sc.events[nextEvent].atMs <= nowMs) {
+            const Event &ev = sc.events[nextEvent++];
+            if (ev.kind == Event::JOY) {
+                hostSetAnalog(JOYSTICK_X_PIN, ev.a);
+                hostSetAnalog(JOYSTICK_Y_PIN, ev.b);
+            } else if (ev.kind == Event::STALL) {
+                supervisorBegin(STAGE_DISPLAY);
+                stallEndUs = t + (unsigned long long)ev.a * 1000;
+                stalled = true;
+            } else {
+                hostSetPin(ev.a, ev.kind == Event::PRESS ? LOW : HIGH);
+            }
+            lastInputMs = ev.atMs;
+        }
+        if (stalled && t >= stallEndUs) {
+            supervisorEnd();
+            stalled = false;
+            nextTickUs = t; // loop() runs the overdue tick at once
+        }
+        if (!stalled && t >= nextTickUs) {
+            supervisorTickStart(micros());
+            supervisorBegin(STAGE_CONTROL);
+            controlTick();
+            supervisorEnd();
+            supervisorBegin(STAGE_REPORT); // The serial reports, as loop() runs them
+            memwatchUpdate();
+            supervisorUpdate();
+            traceTick();
+            supervisorEnd();
+            nextTickUs += tickUs;
+        }
+
+        Sample s;
+        s.tMs = t / 1000.0;
+        for (int j = 0; j < 3; ++j) {
+            s.commanded[j] = hostServoAngle(SERVO_PINS[j]);
+            servos[j].step(s.commanded[j], SIM_DT_US / 1e6);
+            s.actual[j] = servos[j].angle;
+        }
+        s.tool = arm.tool(s.actual[0], s.actual[1], s.actual[2]);
+        samples.push_back(s);
+        if (csv) {
+            fprintf(csv, "%s,%.1f,%d,%d,%d,%.2f,%.2f,%.2f,%.1f,%.1f,%.1f\n", sc.name.c_str(), s.tMs,
+                    s.commanded[0], s.commanded[1], s.commanded[2],
+                    s.actual[0], s.actual[1], s.actual[2], s.tool.x, s.tool.y, s.tool.z);
+        }
+        hostAdvanceMicros((uint64_t)SIM_DT_US);
+    }
+
+    Metrics m;
+    const Sample &first = samples.front();
+    const Sample &last = samples.back();
+
+    // Settling: the first time after the last input from which every joint stays near its final angle
+    bool stillMoving = false;
+    for (int j = 0; j < 3; ++j) {
+        if (std::fabs(servos[j].velocity) > MOVING_THRESHOLD_DEG_S) stillMoving = true;
+    }
+    if (!stillMoving) {
+        double settledAt = last.tMs;
+        for (size_t i = samples.size(); i-- > 0 && samples[i].tMs >= lastInputMs;) {
+            bool inBand = true;
+            for (int j = 0; j < 3; ++j) {
+                if (std::fabs(samples[i].actual[j] - last.actual[j]) > SETTLE_TOLERANCE_DEG) inBand = false;
+            }
+            if (!inBand) break;
+            settledAt = samples[i].tMs;
+        }
+        m.settleMs = settledAt - lastInputMs;
+    }
+
+    // Overshoot past the final angle, in each joint's direction of travel after the last input
+    size_t fromIdx = std::min(samples.size() - 1, (size_t)(lastInputMs * 1000 / SIM_DT_US));
+    for (int j = 0; j < 3; ++j) {
+        double travel = last.actual[j] - samples[fromIdx].actual[j];
+        if (std::fabs(travel) < SETTLE_TOLERANCE_DEG) continue;
+        double dir = travel > 0 ? 1.0 : -1.0;
+        for (size_t i = fromIdx; i < samples.size(); ++i) {
+            m.overshootDeg = std::max(m.overshootDeg, dir * (samples[i].actual[j] - last.actual[j]));
+        }
+    }
+
+    double movingMs = 0.0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const Sample &s = samples[i];
+        if (contact.collides(arm, s.actual[0], s.actual[1], s.actual[2])) m.collideMs += SIM_DT_US / 1000.0;
+        m.pathErrorMm = std::max(m.pathErrorMm, distanceToSegment(s.tool, first.tool, last.tool));
+        for (int j = 0; j < 3; ++j) {
+            m.trackErrorDeg = std::max(m.trackErrorDeg, std::fabs(s.commanded[j] - s.actual[j]));
+        }
+        if (i > 0) {
+            double step = distance(s.tool, samples[i - 1].tool);
+            m.travelMm += step;
+            if (step / (SIM_DT_US / 1e6) > 1.0) movingMs += SIM_DT_US / 1000.0;
+        }
+    }
+    m.meanSpeedMmS = movingMs > 0.0 ? m.travelMm / (movingMs / 1000.0) : 0.0;
+    m.commitsPerS = servoCommitCount / (sc.endMs / 1000.0);
+    m.overruns = supervisorOverruns();
+    return m;
+}
+
+// Print into a file, for the trace dump
+class FilePrint : public Print {
+public:
+    explicit FilePrint(FILE* f) : f_(f) {}
+    size_t write(uint8_t c) override { return fputc(c, f_) == EOF ? 0 : 1; }
+private:
+    FILE* f_;
+};
+
+int main(int argc, char** argv) {
+    const char* csvPath = NULL;
+    const char* tracePath = NULL;
+    std::vector<const char*> files;
+    hostSerialTxBuffer(true); // Reports that would block the loop show up as overruns
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--csv") && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (!strcmp(argv[i], "--trace") && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (!strcmp(argv[i], "--serial")) {
+            hostSerialEcho(true);
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+    if (files.empty()) {
+        fprintf(stderr, "usage: sim [--csv trajectory.csv] [--trace trace.txt] [--serial] scenario.scn...\n");
+        return 2;
+    }
+
+    FILE* csv = NULL;
+    if (csvPath) {
+        csv = fopen(csvPath, "w");
+        if (!csv) {
+            fprintf(stderr, "sim: cannot write %s\n", csvPath);
+            return 1;
+        }
+        fprintf(csv, "scenario,t_ms,cmd1,cmd2,cmd3,act1,act2,act3,tool_x,tool_y,tool_z\n");
+    }
+    FILE* trace = NULL;
+    if (tracePath) {
+        trace = fopen(tracePath, "w");
+        if (!trace) {
+            fprintf(stderr, "sim: cannot write %s\n", tracePath);
+            return 1;
+        }
+    }
+
+    printf("%-22s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "scenario", "settle_ms", "overshoot",
+           "path_err", "travel_mm", "speed_mms", "track_err", "commits/s", "collide_ms", "overruns");
+    int failures = 0;
+    for (const char* file : files) {
+        Scenario sc;
+        if (!loadScenario(file, sc)) {
+            ++failures;
+            continue;
+        }
+        Metrics m = runScenario(sc, csv);
+        if (trace) {
+            // The ring keeps the last TRACE_RECORDS events, or the lead-up to a fault
+            fprintf(trace, "# scenario %s\n", sc.name.c_str());
+            FilePrint out(trace);
+            traceDump(out);
+        }
+        char settle[16];
+        if (m.settleMs < 0) snprintf(settle, sizeof(settle), "unsettled");
+        else snprintf(settle, sizeof(settle), "%.0f", m.settleMs);
+        printf("%-22s %10s %10.2f %10.1f %10.1f %10.1f %10.2f %10.1f %10.0f %10lu\n", sc.name.c_str(), settle,
+               m.overshootDeg, m.pathErrorMm, m.travelMm, m.meanSpeedMmS, m.trackErrorDeg, m.commitsPerS, m.collideMs,
+               m.overruns);
+    }
+    if (csv) fclose(csv);
+    if (trace) fclose(trace);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Convert an event trace dump (include/trace.h) to Chrome trace / Perfetto JSON.
+
+The input is a serial capture of the firmware's dump (send 't'), or the file
+written by `tools/build/sim --trace`. Lines outside "# trace begin" .. "# trace
+end" are ignored, so the capture may hold other serial output too. Every dump
+in the file becomes its own process in the timeline.
+
+Open the result at https://ui.perfetto.dev or chrome://tracing.
+
+Usage: python3 tools/trace2perfetto.py capture.txt [out.json]
+  out.json defaults to the capture name with .json
+"""
+
+import json
+import sys
+
+# Keep in sync with TraceTag in include/trace.h
+TRACE_BUTTON = 0
+TRACE_JOYSTICK = 1
+TRACE_SERVO = 2          # + axis 0..ARM_MAX_AXES-1
+ARM_MAX_AXES = 5
+TRACE_MAGNET = 7
+TRACE_DISPLAY_BEGIN = 8
+TRACE_DISPLAY_END = 9
+TRACE_FAULT = 10
+
+TIME_WRAP = 1 << 24      # Timestamps are 24-bit timer0 ticks
+
+FAULT_CAUSES = ["none", "watchdog", "overrun"]
+STAGES = ["idle", "link", "control", "report", "display_boot", "display"]
+
+# Thread ids inside each dump's process
+TID_INPUT, TID_SERVOS, TID_DISPLAY, TID_SUPERVISOR = 1, 2, 3, 4
+THREAD_NAMES = {TID_INPUT: "input", TID_SERVOS: "servos", TID_DISPLAY: "display", TID_SUPERVISOR: "supervisor"}
+
+
+def parse_dumps(path):
+    """Yields one dict per complete dump: header fields, names and records."""
+    dump, scenario = None, None
+    with open(path, errors="replace") as f:
+        for line in f:
+            parts = line.split()
+            if line.startswith("# scenario ") and len(parts) >= 3:
+                scenario = parts[2]
+                continue
+            if line.startswith("# trace begin"):
+                fields = dict(p.split("=", 1) for p in parts[3:] if "=" in p)
+                dump = {"tick_us": float(fields.get("tick_us", 4)),
+                        "prev": fields.get("prev") == "1",
+                        "names": {"button": {}, "display": {}},
+                        "records": [],
+                        "label": scenario}
+            elif dump is None:
+                continue
+            elif line.startswith("# trace name") and len(parts) >= 6:
+                dump["names"].setdefault(parts[3], {})[int(parts[4])] = " ".join(parts[5:])
+            elif line.startswith("# trace end"):
+                yield dump
+                dump = None
+            elif parts and parts[0] == "T" and len(parts) == 4:
+                try:
+                    dump["records"].append((int(parts[1], 16), int(parts[2], 16), int(parts[3], 16)))
+                except ValueError:
+                    pass  # Line garbled on the wire
+
+
+def convert(dump, pid):
+    names = dump["names"]
+    label = "trace %d" % pid
+    if dump["label"]:
+        label += " (%s)" % dump["label"]
+    if dump["prev"]:
+        label += " before watchdog reset"
+    events = [{"ph": "M", "pid": pid, "name": "process_name", "args": {"name": label}}]
+    for tid, name in THREAD_NAMES.items():
+        events.append({"ph": "M", "pid": pid, "tid": tid, "name": "thread_name", "args": {"name": name}})
+
+    def counter(ts, name, value):
+        events.append({"ph": "C", "pid": pid, "tid": TID_INPUT, "ts": ts, "name": name, "args": {"value": value}})
+
+    def instant(ts, tid, name, args=None):
+        events.append({"ph": "i", "s": "t", "pid": pid, "tid": tid, "ts": ts, "name": name, "args": args or {}})
+
+    base, last = 0, None
+    open_task = None
+    for tag, ticks, value in dump["records"]:
+        if last is not None and ticks < last:
+            base += TIME_WRAP
+        last = ticks
+        ts = (base + ticks) * dump["tick_us"]
+
+        if tag == TRACE_BUTTON:
+            idx, level = value >> 8, value & 0xFF
+            name = names["button"].get(idx, "button %d" % idx)
+            pressed = level == 0
+            counter(ts, "button " + name, 1 if pressed else 0)
+            instant(ts, TID_INPUT, "%s %s" % (name, "pressed" if pressed else "released"))
+        elif tag == TRACE_JOYSTICK:
+            # Recorded as X >> 2, Y >> 2; scaled back to the raw 0..1023 range
+            events.append({"ph": "C", "pid": pid, "tid": TID_INPUT, "ts": ts, "name": "joystick",
+                           "args": {"x": (value >> 8) << 2, "y": (value & 0xFF) << 2}})
+        elif TRACE_SERVO <= tag < TRACE_SERVO + ARM_MAX_AXES:
+            axis = tag - TRACE_SERVO
+            events.append({"ph": "C", "pid": pid, "tid": TID_SERVOS, "ts": ts,
+                           "name": "servo%d" % (axis + 1), "args": {"deg": value / 100.0}})
+        elif tag == TRACE_MAGNET:
+            counter(ts, "magnet", value)
+        elif tag == TRACE_DISPLAY_BEGIN:
+            if open_task is not None:  # End lost to the ring wrapping; close it here
+                events.append({"ph": "E", "pid": pid, "tid": TID_DISPLAY, "ts": ts})
+            open_task = value
+            name = names["display"].get(value, "task %d" % value)
+            events.append({"ph": "B", "pid": pid, "tid": TID_DISPLAY, "ts": ts, "name": name})
+        elif tag == TRACE_DISPLAY_END:
+            if open_task is None:
+                continue  # Its begin was overwritten
+            open_task = None
+            events.append({"ph": "E", "pid": pid, "tid": TID_DISPLAY, "ts": ts,
+                           "args": {"completed": bool(value & 0x100)}})
+        elif tag == TRACE_FAULT:
+            cause, stage = value >> 8, value & 0xFF
+            instant(ts, TID_SUPERVISOR, "fault: %s" % (FAULT_CAUSES[cause] if cause < len(FAULT_CAUSES) else cause),
+                    {"stage": STAGES[stage] if stage < len(STAGES) else stage})
+        else:
+            instant(ts, TID_SUPERVISOR, "tag 0x%02x" % tag, {"value": value})
+    return events
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    if len(args) not in (1, 2):
+        print(__doc__)
+        return 2
+    src = args[0]
+    out = args[1] if len(args) == 2 else src.rsplit(".", 1)[0] + ".json"
+
+    events = []
+    count = 0
+    for count, dump in enumerate(parse_dumps(src), 1):
+        events += convert(dump, count)
+    if count == 0:
+        sys.stderr.write("%s: no complete trace dump found\n" % src)
+        return 1
+    with open(out, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ms"}, f)
+    print("%s: %d dump(s), %d events -> %s" % (src, count, len(events), out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())